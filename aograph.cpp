@@ -5,121 +5,34 @@
 // Description	: AND-OR graph
 //===============================================================================//
 
-#include "aograph.h"
-
-//! constructor of class Path
-//! @param[in] cost 	initial cost of the path
-//! @param[in] index 	unique index of the path
-Path::Path(int cost, int index)
-{
-    pIndex = index;
-    pCost = cost;
-    pComplete = false;
-}
-
-//! copy constructor of class Path
-//! @param[in] &toBeCopied  path to be copied
-//! @param[in] index        unique index of the path
-Path::Path(const Path &toBeCopied, int index)
-{
-    pIndex = index;
-    pCost = toBeCopied.pCost;
-    pComplete = false;
-    pathNodes = toBeCopied.pathNodes;
-    pathArcs = toBeCopied.pathArcs;
-    checkedNodes = toBeCopied.checkedNodes;
-}
-
-//! display path information
-void Path::printPathInfo()
-{
-    cout<<"Info of path: " <<pIndex <<endl;
-    //DEBUG: cout<<"Is complete? " <<boolalpha <<pComplete <<endl;
-    cout<<"Total cost: " <<pCost <<endl;
-    cout<<"Hyperarcs in path: ";
-    for (int i=0; i< (int)pathArcs.size(); i++)
-        cout<<pathArcs[i] <<" ";
-    cout<<endl <<"Nodes in path:" <<endl;
-    for (int i=0; i< (int)pathNodes.size(); i++)
-    {
-        cout<<pathNodes[i]->nName <<" ";
-        //DEBUG: cout<<"checked? " <<boolalpha <<checkedNodes[i];
-        if (checkedNodes[i] == true)
-            cout<<"- done";
-        cout<<endl;
-    }
-    cout<<endl;
-}
-
-//! add a node in the path
-//! @param[in] node     node to add to the path
-void Path::addNode(AOnode* node)
-{
-    // update the nodes in the path
-    pathNodes.push_back(node);
-    checkedNodes.push_back(false);
-    
-    // N.B. the cost of the path is updated when the node is checked
-}
-
-//! update the path information (when a node is solved)
-//! @param[in] nameNode     name of the node
-//! @param[in] cost         cost to subtract from the path cost
-void Path::updatePath(string nameNode, int cost)
-{
-   // check whether the node is in the path
-    for(int i=0; i < (int)pathNodes.size(); i++)
-    {
-        // keep track of solved nodes
-        if (pathNodes[i]->nName == nameNode)
-            checkedNodes[i] = true;
-    }
-    // update the cost of the path        
-    pCost = pCost - cost;
-    
-    cout<<"Path: " <<pIndex <<endl;
-    cout<<"Updated path cost: " <<pCost <<endl;
-}
+#include <cstring>
+#include <thread>
 
-//! find the feasible node to suggest
-//! @return node to suggest
-AOnode* Path::suggestNode()
-{
-    AOnode* selection = NULL;
-    
-    // iterate on the nodes in the path, from the last to the first one
-    for (int i = (int)pathNodes.size()-1; i > -1; i--)
-    {
-        // rationale for the suggestion:
-        // 1. move along the path from the leaves to the head
-        // 2. choose the first feasible & not-solved node
-        if (checkedNodes[i] == false)
-        {
-            if (pathNodes[i]->nFeasible == true)
-            {
-                selection = pathNodes[i];
-                break;
-            }
-        }
-    }
-    
-    // raise an error if the suggested node is NULL
-    if (selection == NULL)
-        cout<<"[ERROR] No suggestion possible." <<endl;
-    
-    return selection;
-}
+#include "aograph.h"
+#include "descriptionreader.h"
+#include "pathgenerator.h"
+#include "pathiterator.h"
+#include "rolloutplanner.h"
 
 //! add a node in the graph
 //! @param[in] nameNode    name of the node
 //! @param[in] cost        generic node cost
 void AOgraph::addNode(string nameNode, int cost)
 {
-    // create the node
+    // raise an error if a node with the same name exists
+    if (nameIndex.find(nameNode) != -1)
+    {
+        ENDOR_MESSAGE("[ERROR] The node " <<nameNode <<" already exists.");
+        return;
+    }
+    
+    // create the node: its identifier is its position in the graph
     AOnode toAdd(nameNode, cost);
+    toAdd.nId = graph.size();
     
     // add it to the set of nodes in the graph
     graph.push_back(toAdd);
+    nameIndex.insert(toAdd.nId);
 }
 
 //! find a node by name
@@ -129,27 +42,82 @@ AOnode* AOgraph::findByName(string nameNode)
 {
     AOnode* temp = NULL;
     
-    for (int i=0; i< (int)graph.size(); i++)
-    {
-        if (graph[i].nName == nameNode)
-        {
-            temp = &graph[i];
-            break;
-        }
-    }
+    int found = nameIndex.find(nameNode);
+    if (found != -1)
+        temp = &graph[found];
     
     // issue a warning if the node has not been found
     if (temp == NULL)
-        cout<<"[Warning] Name not found."
-            <<"Did you really look for " <<nameNode <<"?" <<endl;
+        ENDOR_MESSAGE("[Warning] Name not found."
+            <<"Did you really look for " <<nameNode <<"?");
     return temp;
 }
 
 //! update the feasibility status of the nodes in the graph
 void AOgraph::updateNodeFeasibility()
 {
-    for (int i=0; i< (int)graph.size(); i++)
-        graph[i].isFeasible();        
+    ENDOR_TIME_PHASE(stats, PHASE_FEASIBILITY);
+    ENDOR_COUNT(stats.nodesVisited, compiled.numNodes);
+    
+    // 1. each hyperarc counts its distinct child nodes not solved yet
+    // 2. a node is feasible if it is already feasible, if it is terminal or
+    //    if it has >=1 hyperarcs with all child nodes solved
+    frontier.clear();
+    arcUnsolved.assign(compiled.numArcs(), 0);
+    vector<int> lastArc(compiled.numNodes, -1);
+    for (int i=0; i< compiled.numNodes; i++)
+    {
+        AOnode* current = compiled.node[i];
+        bool feasible = (current->nFeasible == true) || (compiled.arcOffset[i] == compiled.arcOffset[i+1]);
+        for (int a = compiled.arcOffset[i]; a < compiled.arcOffset[i+1]; a++)
+        {
+            for (int c = compiled.childOffset[a]; c < compiled.childOffset[a+1]; c++)
+            {
+                // a child listed twice in a hyperarc is counted once
+                int child = compiled.childNode[c];
+                if (lastArc[child] == a)
+                    continue;
+                lastArc[child] = a;
+                if (compiled.node[child]->nSolved == false)
+                    arcUnsolved[a]++;
+            }
+            if (arcUnsolved[a] == 0)
+                feasible = true;
+        }
+        current->nFeasible = feasible;
+        
+        // N.B. the nodes are visited in identifier order: insert at the end
+        if ((current->nFeasible == true) && (current->nSolved == false))
+            frontier.insert(frontier.end(), i);
+    }
+}
+
+//! update the feasibility status of the parents of a solved node
+//! @param[in] solved       reference to the solved node
+void AOgraph::updateParentsFeasibility(AOnode &solved)
+{
+    // 1. the solved node leaves the frontier
+    // 2. each hyperarc including the solved node has one less child to solve
+    // 3. a parent becomes feasible when one of its hyperarcs has no child to solve
+    // N.B. only the parents are visited, not the whole graph
+    ENDOR_TIME_PHASE(stats, PHASE_FEASIBILITY);
+    ENDOR_COUNT(stats.nodesVisited, compiled.parentOffset[solved.nId+1] - compiled.parentOffset[solved.nId]);
+    frontier.erase(solved.nId);
+    
+    // a parent is listed once per hyperarc including the solved node
+    for (int k = compiled.parentOffset[solved.nId]; k < compiled.parentOffset[solved.nId+1]; k++)
+    {
+        int arc = compiled.parentArc[k];
+        arcUnsolved[arc] = arcUnsolved[arc] - 1;
+        
+        AOnode* parent = compiled.node[compiled.parentNode[k]];
+        if ((arcUnsolved[arc] == 0) && (parent->nFeasible == false))
+        {
+            parent->nFeasible = true;
+            if (parent->nSolved == false)
+                frontier.insert(parent->nId);
+        }
+    }
 }
 		
 //! compute the cost to add to a path
@@ -165,8 +133,8 @@ int AOgraph::computeAddCost(AOnode &node, int hIndex)
     // raise an error if the hyperarc index is out of bounds
     if (hIndex >= (int)node.arcs.size())
     {
-        cout<<"[ERROR] The node has only " <<node.arcs.size() <<" hyperarcs."
-            <<"Hyperarc index " <<hIndex <<" does not exist." <<endl;
+        ENDOR_MESSAGE("[ERROR] The node has only " <<node.arcs.size() <<" hyperarcs."
+            <<"Hyperarc index " <<hIndex <<" does not exist.");
         return -1;
     }
         
@@ -187,130 +155,189 @@ void AOgraph::generatePaths()
     // if the head node is NULL, there are no paths to generate
     if (head == NULL)
     {
-        cout<<"[WARNING] There is no graph to navigate (head == NULL)." <<endl;
+        ENDOR_MESSAGE("[WARNING] There is no graph to navigate (head == NULL).");
+        return;
+    }
+    ENDOR_TIME_PHASE(stats, PHASE_GENERATION);
+    
+    // otherwise, start from an empty set of paths
+    paths.clear();
+    paths.head = head;
+    paths.compiled = &compiled;
+    
+    // the paths can be completed in parallel, with the same indices
+    if (gThreads > 1)
+    {
+        PathGenerator generator(&compiled, gThreads);
+        generator.generate(head->nId, paths);
+        ENDOR_COUNT(stats.pathsCreated, paths.size());
+        ENDOR_COUNT(stats.pathsCopied, paths.size()-1);
+        ENDOR_COUNT(stats.nodesVisited, generator.visitedNodes());
         return;
     }
     
-    // otherwise, create a path with the head node
-    Path* newPath = new Path(0,0);
-    newPath->addNode(head);
-    paths.push_back(*newPath);
+    // create a path with the head node
+    paths.addPath(0, -1, 1);
+    
+    // position of the first not-checked node of each path
+    // N.B. the nodes of a path are checked in order, from the head node
+    vector<int> firstUnchecked(1, 0);
+    
+    // complete the paths in order: the copies of a path are added at the end
+    // of the set of paths, hence they are completed after the copied path
+    vector<int> pathNodes;
+    vector<int> pathArcs;
+    for (int currentPathIndex=0; currentPathIndex < paths.size(); currentPathIndex++)
+    {
+        paths.expand(currentPathIndex, pathNodes, pathArcs);
         
-    // iterate through the paths until they're all complete
-    AOnode* currentNode = head;
-    while(1)
-    {
-        // find the first not-complete path
-        bool allComplete = true;
-        int currentPathIndex;
-        for (int i=0; i< (int)paths.size(); i++)
-        {
-            if (paths[i].pComplete == false)
-            {
-                allComplete = false;
-                currentPathIndex = i;
-                break;
-            }
-        }
-        // if all paths are complete, the generation is done
-        if (allComplete == true)
-            return;
-            
-        // find the first not-checked node in the open path
-        bool allChecked = true;
-        int currentNodeIndex;
-        for (int i=0; i< (int)paths[currentPathIndex].checkedNodes.size(); i++)
-        {
-            if (paths[currentPathIndex].checkedNodes[i] == false)
-            {
-                allChecked = false;
-                currentNode = paths[currentPathIndex].pathNodes[i];
-                currentNodeIndex = i;
-                break;
-            }
-        }
         // if all nodes are checked, the path is complete
-        if (allChecked == true)
-            paths[currentPathIndex].pComplete = true;
-        else
+        for (int currentNodeIndex = firstUnchecked[currentPathIndex];
+             currentNodeIndex < (int)pathNodes.size(); currentNodeIndex++)
         {
+            int currentNode = pathNodes[currentNodeIndex];
+            int firstArc = compiled.arcOffset[currentNode];
+            int numNodeArcs = compiled.arcOffset[currentNode+1] - firstArc;
+            
             // if the current node is terminal:
             // 1. check it
             // 2. update the path cost with the current node cost
-            if (currentNode->arcs.size() == 0)
-            {
-                paths[currentPathIndex].checkedNodes[currentNodeIndex] = true;
-                int cost = computeAddCost(*currentNode, -1);
-                paths[currentPathIndex].pCost = paths[currentPathIndex].pCost + cost;
-            }
-            
-            // if the current node has only one hyperarc:
-            // 1. check it
-            // 2. add the hyperarc index to the path
-            // 3. update the path cost with the current node+only_hyperarc cost
-            // 4. add its child nodes to the path
-            if (currentNode->arcs.size() == 1)
+            if (numNodeArcs == 0)
             {
-                paths[currentPathIndex].checkedNodes[currentNodeIndex] = true;
-                paths[currentPathIndex].pathArcs.push_back(currentNode->arcs[0].hIndex);
-                int cost = computeAddCost(*currentNode, 0);
-                paths[currentPathIndex].pCost = paths[currentPathIndex].pCost + cost;
-                for (int i=0; i< (int)currentNode->arcs[0].children.size(); i++)
-                    paths[currentPathIndex].addNode(currentNode->arcs[0].children[i]);
+                int cost = compiled.nodeCost[currentNode];
+                paths.costs[currentPathIndex] = paths.costs[currentPathIndex] + cost;
+                continue;
             }
             
             // if the current node has more than one hyperarc:
-            // 1. create (numArcs-1) copies of the current path
-            // 2. check the current node in the copies
-            // 3. add the other_hyperarc index to the copies
-            // 4. update the path cost with the current node+other_hyperarc cost
-            // 5. add the child nodes of the last (numArcs-1) arcs to the copies
-            // 6. check the current node in the current path
-            // 7. add the first_hyperarc index to the current path
-            // 8. update the path cost with the current node+first_hyperarc cost
-            // 9. add the child nodes of the first arcs to the current path
-            if (currentNode->arcs.size() > 1)
+            // 1. create (numArcs-1) copies of the current path, sharing its steps
+            // 2. add the other_hyperarc step to the copies
+            // 3. update the path cost with the current node+other_hyperarc cost
+            // 4. check the current node in the copies
+            // N.B. branching costs one step per copy, whatever the path length
+            int numCopies = numNodeArcs-1;
+            for (int i=0; i<numCopies; i++)
             {
-                int numCopies = currentNode->arcs.size()-1;
-                for (int i=0; i<numCopies; i++)
-                {
-                    newPath = new Path(paths[currentPathIndex], paths.size());
-                    newPath->checkedNodes[currentNodeIndex] = true;
-                    newPath->pathArcs.push_back(currentNode->arcs[i+1].hIndex);
-                    int cost = computeAddCost(*currentNode, i+1);
-                    newPath->pCost = newPath->pCost + cost;
-                    for (int j=0; j< (int)currentNode->arcs[i+1].children.size(); j++)
-                        newPath->addNode(currentNode->arcs[i+1].children[j]);
-                    paths.push_back(*newPath);
-                }
-                paths[currentPathIndex].checkedNodes[currentNodeIndex] = true;
-                paths[currentPathIndex].pathArcs.push_back(currentNode->arcs[0].hIndex);
-                int cost = computeAddCost(*currentNode, 0);
-                paths[currentPathIndex].pCost = paths[currentPathIndex].pCost + cost;
-                for (int i=0; i< (int)currentNode->arcs[0].children.size(); i++)
-                    paths[currentPathIndex].addNode(currentNode->arcs[0].children[i]);
+                int arc = firstArc+i+1;
+                int step = paths.addStep(paths.entries[currentPathIndex].eLastStep, currentNode, i+1);
+                int cost = compiled.nodeCost[currentNode] + compiled.arcCost[arc];
+                int length = pathNodes.size() + compiled.childOffset[arc+1] - compiled.childOffset[arc];
+                paths.addPath(paths.costs[currentPathIndex] + cost, step, length);
+                firstUnchecked.push_back(currentNodeIndex+1);
             }
+            
+            // for the current path (the only one, if the node has one hyperarc):
+            // 1. check the current node
+            // 2. add the first_hyperarc step to the path
+            // 3. update the path cost with the current node+first_hyperarc cost
+            // 4. add the child nodes of the first hyperarc to the path
+            int step = paths.addStep(paths.entries[currentPathIndex].eLastStep, currentNode, 0);
+            int cost = compiled.nodeCost[currentNode] + compiled.arcCost[firstArc];
+            paths.entries[currentPathIndex].eLastStep = step;
+            paths.costs[currentPathIndex] = paths.costs[currentPathIndex] + cost;
+            pathNodes.insert(pathNodes.end(), compiled.childNode.begin() + compiled.childOffset[firstArc],
+                compiled.childNode.begin() + compiled.childOffset[firstArc+1]);
+            paths.entries[currentPathIndex].eLength = pathNodes.size();
         }
+        paths.entries[currentPathIndex].eComplete = true;
+        ENDOR_COUNT(stats.nodesVisited, pathNodes.size() - firstUnchecked[currentPathIndex]);
+    }
+    ENDOR_COUNT(stats.pathsCreated, paths.size());
+    ENDOR_COUNT(stats.pathsCopied, paths.size()-1);
+}
+
+//! determine whether the paths fit in the budget (before generating them)
+//! N.B. over budget, either the solution graph engine is used instead, or
+//! the graph is left empty (as an invalid description would)
+//! @return     true if the graph can be set up with the current engine
+bool AOgraph::checkPathBudget()
+{
+    // a cycle makes the paths infinite, and no engine can navigate it
+    double numPaths = 0.0;
+    double totalLength = 0.0;
+    if (countPaths(numPaths, totalLength) == false)
+    {
+        ENDOR_MESSAGE("[ERROR] The graph has a cycle: the paths navigating it are infinite. "
+            <<"The graph is not loaded.");
+        clearGraph();
+        return false;
+    }
+    
+    double numBytes = PathStore::estimateMemory(numPaths, totalLength, numArcs);
+    if (((maxPaths <= 0) || (numPaths <= maxPaths)) && ((maxPathBytes <= 0) || (numBytes <= maxPathBytes)))
+        return true;
+    ENDOR_MESSAGE("[WARNING] The graph has " <<numPaths <<" paths (about " <<numBytes
+        <<" bytes), over the budget.");
+    
+    if (budgetFallback == true)
+    {
+        ENDOR_MESSAGE("[REPORT] Using the solution graph engine.");
+        gEngine = ENGINE_SOLUTION_GRAPH;
+        return true;
     }
+    
+    ENDOR_MESSAGE("[ERROR] The paths do not fit in the budget. The graph is not loaded.");
+    clearGraph();
+    return false;
+}
+
+//! leave the graph empty (as an invalid description would)
+void AOgraph::clearGraph()
+{
+    graph.clear();
+    nameIndex.clear();
+    compiled.clear();
+    head = NULL;
+    numArcs = 0;
+    costToGo.clear();
+    deviations.clear();
 }
 
 //! set up a graph
 void AOgraph::setupGraph()
 {
+    ENDOR_TIME_PHASE(stats, PHASE_SETUP);
+    
+    // the paths are counted before enumerating them
+    if ((gEngine == ENGINE_PATHS) && (checkPathBudget() == false))
+        return;
+    
     // update the feasibility status of the nodes in the graph
     updateNodeFeasibility();
     //DEBUG:printGraphInfo();
     
+    // no hyperarc has benefitted from solved nodes yet
+    arcBenefit.assign(compiled.numArcs(), 0);
+    
+    // the solution graph engine does not enumerate the paths:
+    // the optimal path is built from the cost-to-go of the nodes
+    if (gEngine == ENGINE_SOLUTION_GRAPH)
+    {
+        // N.B. a cycle is found here when the solution graph engine is chosen
+        // from the start (the paths engine finds it counting the paths)
+        if (computeSolutionGraph() == false)
+        {
+            ENDOR_MESSAGE("[ERROR] The graph is not loaded.");
+            clearGraph();
+            return;
+        }
+        
+        for (int i=0; i< (int)observers.size(); i++)
+            observers[i]->onLoadFinished(*this);
+        
+        // identify the first suggestion to make (long-sighted strategy chosen BY DEFAULT)
+        suggestNext(true);
+        return;
+    }
+    
     // generate all paths navigating the graph
-    generatePaths();
-    // set the "checked" property of the nodes in the paths to false
     // NOTE: during execution, "checked" is used to mark the solved nodes
-    for (int i=0; i < (int)paths.size(); i++)
-        for (int j=0; j < (int)paths[i].checkedNodes.size(); j++)
-            paths[i].checkedNodes[j] = false;
-
-    for (int i=0; i < (int)paths.size(); i++)
-        paths[i].printPathInfo();
+    generatePaths();
+    // index the paths including each node and hyperarc
+    paths.buildIndex(graph.size(), numArcs);
+    
+    for (int i=0; i< (int)observers.size(); i++)
+        observers[i]->onLoadFinished(*this);
             
     // identify the first suggestion to make (long-sighted strategy chosen BY DEFAULT)
     suggestNext(true);
@@ -323,25 +350,21 @@ void AOgraph::setupGraph()
 HyperArc* AOgraph::findHyperarc(AOnode &parent, AOnode &child)
 {
     HyperArc* temp = NULL;
+    ENDOR_COUNT(stats.arcLookups, 1);
     
-    for (int j=0; j< (int)parent.arcs.size(); j++)
+    // if several hyperarcs connect the parent to the child, use the last one
+    int arc = compiled.findLink(parent.nId, child.nId);
+    if (arc != -1)
     {
-        for (int k=0; k< (int)parent.arcs[j].children.size(); k++)
-        {
-            if(parent.arcs[j].children[k]->nName == child.nName)
-            {
-                temp = &parent.arcs[j];
-                //DEBUG:cout<<"Found index: " <<temp->hIndex <<endl;
-                break;
-            }
-        }
+        temp = &parent.arcs[arc - compiled.arcOffset[parent.nId]];
+        //DEBUG:cout<<"Found index: " <<temp->hIndex <<endl;
     }
     
     /* DEBUG
     // raise a warning if no hyperarc was found
     if (temp == NULL)
-        cout<<"[WARNING] There is no hyperarc connecting " <<parent.nName
-            <<" to " <<child.nName <<"." <<endl;
+        ENDOR_MESSAGE("[WARNING] There is no hyperarc connecting " <<parent.nName
+            <<" to " <<child.nName <<".");
     */
     
     return temp;    
@@ -350,7 +373,7 @@ HyperArc* AOgraph::findHyperarc(AOnode &parent, AOnode &child)
 //! compute the overall update cost (intermediate step to update the path cost)
 //! @param[in] node     reference to the node to use for cost computation
 //! @return             overall update cost (to subtract from the path cost)
-int AOgraph::computeOverallUpdate(AOnode &node)
+int AOgraph::computeOverallUpdate(const AOnode &node) const
 {    
     // 1. the cost is to be SUBTRACTED from the cost of the path
     // 2. the cost is computed as:
@@ -360,310 +383,1396 @@ int AOgraph::computeOverallUpdate(AOnode &node)
     // N.B. the cost is to be subtracted from path[i] as:
     // 1. toSubtract = node.nCost + abs(pathsCosts[path_i] - cost);
     
-    vector<int> pathsCosts;
-    
-    // for each parent node, find the cost of the hyperarc to the current node
-    for (int i=0; i< (int)node.parents.size(); i++)
+    // for each parent node, the hyperarc to the current node is its link
+    // N.B. a node without parents (e.g., the head node) has no update
+    int cost = 0;
+    bool found = false;
+    for (int k = compiled.parentOffset[node.nId]; k < compiled.parentOffset[node.nId+1]; k++)
     {
-        HyperArc* arc = findHyperarc(*node.parents[i], node);
-        if (arc != NULL)
-        {
-            int arcCost = arc->hCost;
-            pathsCosts.push_back(arcCost);
-        }
+        if (compiled.isLink(node.nId, k) == false)
+            continue;
+        int arcCost = compiled.arcCost[compiled.parentArc[k]];
+        if ((found == false) || (arcCost > cost))
+            cost = arcCost;
+        found = true;
     }
-    /* DEBUG
-    cout<<"maxUpdate is the max of: ";
-    for (int i=0; i< (int)pathsCosts.size(); i++)
-        cout<<pathsCosts[i] <<" ";
-    cout<<endl;
-    */
-    
-    // find the maximum in pathsCosts
-    int cost = pathsCosts[0];
-    for (int i=1; i< (int)pathsCosts.size(); i++)
-        if (pathsCosts[i] > cost)
-            cost = pathsCosts[i];
     //DEBUG:cout<<"maxUpdate = " <<cost <<endl;
     
     return cost;
 }
 
-//! update all paths (update path costs when a node is solved)
-//! @param[in] solved       reference to the solved node (to use for paths costs update)
-void AOgraph::updatePaths(AOnode &solved)
+//! compute the updates of the paths when a node is solved (without applying them)
+//! N.B. a path is listed once per update, in the order the updates are applied
+//! @param[in] solved       reference to the solved node
+//! @param[out] indices     indices of the updated paths
+//! @param[out] updates     costs of the links of the updated paths ("path_i_update")
+//! @param[out] subtracts   costs to subtract from the updated paths
+//! @return                 number of lookups of a hyperarc in a path
+int AOgraph::computePathUpdates(const AOnode &solved, vector<int> &indices,
+    vector<int> &updates, vector<int> &subtracts) const
 {
     // update the path information (cost) of EACH path as:
     // toSubtract = solved.nCost + overall_update - path_i_update;
     // path[i].cost = path[i].cost - toSubtract;
     
-    pIndices.clear();
-    pUpdate.clear();
+    indices.clear();
+    updates.clear();
+    subtracts.clear();
     int toSubtract = solved.nCost + computeOverallUpdate(solved);
     //DEBUG:cout<<"solved.nCost = " <<solved.nCost <<endl;
     //DEBUG:cout<<"maxUpdate = " <<computeOverallUpdate(solved) <<endl;
     
-    // find all paths which include the solved node
-    vector<int> withChild;
-    for (int i=0; i < (int)paths.size(); i++)
-        for (int j=0; j< (int)paths[i].pathNodes.size(); j++)
-            if(paths[i].pathNodes[j]->nName == solved.nName)
-                withChild.push_back(i);
-    /* DEBUG
-    cout<<"Paths with solved node: ";
-    for (int i=0; i < (int)withChild.size(); i++)
-        cout<<"Path index: " <<withChild[i] <<" ";
-    cout<<endl;
-    */
+    // find the DIRECT LINKS between the solved node and its parents
+    // N.B. a parent is listed once per hyperarc including the solved node
+    vector<int> linkParents;
+    vector<int> links;
+    for (int k = compiled.parentOffset[solved.nId]; k < compiled.parentOffset[solved.nId+1]; k++)
+    {
+        if (compiled.isLink(solved.nId, k) == false)
+            continue;
+        linkParents.push_back(compiled.parentNode[k]);
+        links.push_back(compiled.parentArc[k]);
+    }
     
-    // find the paths including the solved node AND any of its parents
-    vector<int> withBoth;
-    int toAdd;
-    for (int i=0; i < (int)withChild.size(); i++)
+    // only the paths including a direct link are updated
+    vector<int> updated;
+    for (int i=0; i < (int)links.size(); i++)
     {
-        for (int j=0; j < (int)solved.parents.size(); j++)
-            for (int k=0; k < (int)paths[withChild[i]].pathNodes.size(); k++)
-                if(paths[withChild[i]].pathNodes[k]->nName == solved.parents[j]->nName)
-                    toAdd = withChild[i];
-        // make sure that paths are added only ONCE
-        if ( std::find(withBoth.begin(), withBoth.end(), toAdd) == withBoth.end() )
-            withBoth.push_back(toAdd);
+        const vector<PathOccurrence> &withLink = paths.arcPaths[compiled.arcIndex[links[i]]];
+        for (int j=0; j < (int)withLink.size(); j++)
+            updated.push_back(withLink[j].oPath);
     }
-    /* DEBUG
-    cout<<"Paths with solved node & any parent: ";
-    for (int i=0; i < (int)withBoth.size(); i++)
-        cout<<"Path index: " <<withBoth[i] <<" ";
-    cout<<endl;
-    */
-
-    // find the paths containing a DIRECT LINK between the solved node and a parent
-    for (int i=0; i < (int)withBoth.size(); i++)
+    std::sort(updated.begin(), updated.end());
+    updated.erase(std::unique(updated.begin(), updated.end()), updated.end());
+    //DEBUG:cout<<"Paths with a direct link: " <<updated.size() <<endl;
+    
+    vector<int> pathNodes;
+    vector<int> pathArcs;
+    int lookups = 0;
+    for (int i=0; i < (int)updated.size(); i++)
     {
-        for (int j=0; j < (int)paths[withBoth[i]].pathNodes.size(); j++)
+        // find the direct links in THIS path
+        lookups = lookups + links.size();
+        vector<int> inPath;
+        for (int j=0; j < (int)links.size(); j++)
+            if (paths.includesArc(updated[i], compiled.arcIndex[links[j]]) == true)
+                inPath.push_back(j);
+        
+        // the path is updated once per occurrence of each linked parent:
+        // 1. with a single linked parent, its occurrences are counted
+        // 2. otherwise, the updates follow the order of the parents in the path
+        vector<int> order;
+        if (inPath.size() == 1)
+            order.assign(paths.countInPath(paths.nodePaths[linkParents[inPath[0]]], updated[i]), inPath[0]);
+        else
         {
-            HyperArc* arc = findHyperarc(*paths[withBoth[i]].pathNodes[j], solved);
-                    
-            // update the path cost (if there is a direct link in THIS path)
-            if (arc != NULL)
-            {
-                for (int k=0; k < (int)paths[withBoth[i]].pathArcs.size(); k++)
-                {
-                    if (paths[withBoth[i]].pathArcs[k] == arc->hIndex)
-                    {
-                        // compute "path_i_update"
-                        int pathUpdate = arc->hCost;
-                        //DEBUG:cout<<"pathUpdate = " <<pathUpdate <<endl;
-                        int thisSubtract = toSubtract - pathUpdate;
-                        
-                        // update the cost of the path
-                        paths[withBoth[i]].updatePath(solved.nName, thisSubtract);
-                        
-                        // save the index & subtracted cost of the updated path
-                        pIndices.push_back(withBoth[i]);
-                        pUpdate.push_back(pathUpdate);
-                        
-                        break;
-                    }
-                }
-            }
+            paths.expand(updated[i], pathNodes, pathArcs);
+            for (int j=0; j < (int)pathNodes.size(); j++)
+                for (int k=0; k < (int)inPath.size(); k++)
+                    if (pathNodes[j] == linkParents[inPath[k]])
+                        order.push_back(inPath[k]);
+        }
+        
+        for (int j=0; j < (int)order.size(); j++)
+        {
+            // compute "path_i_update"
+            int pathUpdate = compiled.arcCost[links[order[j]]];
+            //DEBUG:cout<<"pathUpdate = " <<pathUpdate <<endl;
+            int thisSubtract = toSubtract - pathUpdate;
+            
+            // save the index, update & subtracted cost of the updated path
+            indices.push_back(updated[i]);
+            updates.push_back(pathUpdate);
+            subtracts.push_back(thisSubtract);
         }
     }
+    
+    return lookups;
+}
+
+//! update all paths (update path costs when a node is solved)
+//! @param[in] solved       reference to the solved node (to use for paths costs update)
+void AOgraph::updatePaths(AOnode &solved)
+{
+    // save the index & subtracted cost of the updated paths, then update them
+    ENDOR_TIME_PHASE(stats, PHASE_UPDATE);
+    vector<int> subtracts;
+    int lookups = computePathUpdates(solved, pIndices, pUpdate, subtracts);
+    ENDOR_COUNT(stats.arcLookups, lookups);
+    for (int i=0; i < (int)pIndices.size(); i++)
+    {
+        paths.updatePath(pIndices[i], &solved, subtracts[i]);
+        for (int k=0; k< (int)observers.size(); k++)
+            observers[k]->onPathUpdated(*this, pIndices[i], paths.costs[pIndices[i]]);
+    }
 }
 
 //! find the optimal path (long-sighted strategy)
 //! @return index of the optimal path (minimum cost)
 int AOgraph::findOptimalPath()
 {
+    ENDOR_TIME_PHASE(stats, PHASE_OPTIMAL_PATH);
+    
     // raise an error if there are no paths
     if (paths.size() == 0)
     {
-        cout<<"[ERROR] There are no paths navigating the graph. "
-            <<"Did you run generatePaths()?" <<endl;
+        ENDOR_MESSAGE("[ERROR] There are no paths navigating the graph. "
+            <<"Did you run generatePaths()?");
         return -1;
     }
     
-    int index = 0;
-    int cost = paths[0].pCost;
-    for (int i=0; i< (int)paths.size(); i++)
+    // raise an error if there are not-complete paths
+    // N.B. the first path with minimum cost is kept up to date by the path cost changes
+    int index = paths.findCheapest();
+    if (index == -1)
     {
-        // raise an error if there are not-complete paths
-        if (paths[i].pComplete == false)
-        {
-            cout<<"[ERROR] The paths navigating the graph are not complete. "
-                <<"Did you run generatePaths()?" <<endl;
-            return -1;
-        }
-        
-        if (paths[i].pCost < cost)
-        {
-            cost = paths[i].pCost;
-            index = i;
-        }
+        ENDOR_MESSAGE("[ERROR] The paths navigating the graph are not complete. "
+            <<"Did you run generatePaths()?");
+        return -1;
     }
-    cout<<"The optimal path is: " <<index <<endl;
-    paths[index].printPathInfo();
     
     return index;
 }
 
-//! constructor of class AOgraph
-//! @param[in] name 	name of the graph
-AOgraph::AOgraph(string name)
+//! find the path with highest benefit from the last solved node (short-sighted strategy)
+//! @param[in] indices  indices of the paths updated by the last solved node
+//! @param[in] updates  costs of the links of the updated paths
+//! @return             index of the path (0 = no path updated)
+int AOgraph::findShortSightedPath(const vector<int> &indices, const vector<int> &updates)
 {
-    gName = name;
-    head = NULL;
+    // N.B. the benefit of the path chosen so far is read at the position
+    // given by its index, as the original selection does: an index beyond
+    // the updated paths is never replaced (instead of reading past the end)
+    int optimalPathIndex = 0;
+    for (int i=1; i< (int)updates.size(); i++)
+        if ((optimalPathIndex < (int)updates.size()) && (updates[i] > updates[optimalPathIndex]))
+            optimalPathIndex = indices[i];
     
-    //DEBUG:printGraphInfo();
+    return optimalPathIndex;
 }
 
-//! load the graph description from a file
-//! @param[in] fileName    name of the file with the graph description
-void AOgraph::loadFromFile(string fileName)
+//! compute the cost-to-go of all nodes reachable from the head node
+//! @return     false if there is no graph or the graph has a cycle (the cost-to-go is not valid)
+bool AOgraph::computeSolutionGraph()
 {
-    // raise an error if the graph is not empty
-    if (graph.size() != 0)
+    // 1. the cost-to-go of a terminal node is its cost
+    // 2. the cost-to-go of a node with hyperarcs is the minimum, over its
+    //    hyperarcs, of node.nCost + hyperarc.hCost + sum(cost-to-go of the child nodes)
+    // N.B. a node shared by many hyperarcs is counted once per occurrence,
+    // exactly as in the paths generated by generatePaths()
+    
+    // if the head node is NULL, there is nothing to compute
+    if (head == NULL)
     {
-        cout<<"[ERROR] The graph is not empty."
-            <<"Do you really want to overwrite the current graph?" <<endl;
-        return;
-    }            
+        ENDOR_MESSAGE("[WARNING] There is no graph to navigate (head == NULL).");
+        return false;
+    }
     
-    ifstream graphFile(fileName.c_str());
-	cout <<"Loading graph description from file: " <<fileName <<endl;
-    
-	while (!graphFile.eof())
-	{
-        // the first line contains:
-        // 1. the name of the graph
-        // 2. the number N=numNodes of nodes
-        // 3. the name of the head node (corresponding to the final assembly)
-        string name;
-        int numNodes;
-        string headName;
-        
-        graphFile >>name >>numNodes >>headName;
-        if (!graphFile)
-			break;
-        gName = name;
+    costToGo.assign(graph.size(), 0);
+    deviations.assign(graph.size(), 0);
+    
+    // visit the nodes in post-order (child nodes first), without recursion
+    // visited: 0 = not visited, 1 = child nodes pending, 2 = cost-to-go computed
+    vector<char> visited(graph.size(), 0);
+    vector<int> toVisit;
+    toVisit.push_back(head->nId);
+    while (toVisit.size() != 0)
+    {
+        int index = toVisit.back();
         
-        // the next N lines contain the name and cost of all the nodes in the graph
-        string nameNode;
-        int cost;
-        for (int i=0; i < numNodes; i++)
-        {            
-            graphFile >>nameNode >> cost;
-            if (!graphFile)
-                break;
-            addNode(nameNode, cost);
+        // first visit: schedule the child nodes not visited yet
+        if (visited[index] == 0)
+        {
+            visited[index] = 1;
+            for (int c = compiled.childOffset[compiled.arcOffset[index]];
+                 c < compiled.childOffset[compiled.arcOffset[index+1]]; c++)
+            {
+                int childIndex = compiled.childNode[c];
+                // raise an error if the graph contains a cycle
+                if (visited[childIndex] == 1)
+                {
+                    ENDOR_MESSAGE("[ERROR] The graph is not acyclic. "
+                        <<"Check the hyperarcs of " <<compiled.node[index]->nName <<".");
+                    return false;
+                }
+                if (visited[childIndex] == 0)
+                    toVisit.push_back(childIndex);
+            }
+            continue;
         }
         
-        // the next ?? lines contain the descriptions of the hyperarcs in the graph
-        int hyperarcIndex = 0;
-        while (!graphFile.eof())
+        toVisit.pop_back();
+        if (visited[index] == 2)
+            continue;
+        
+        // all child nodes are done: keep the cheapest hyperarc
+        // N.B. ties are broken by the number of non-first hyperarcs, then by
+        // hyperarc in buildOptimalPath() (see arcComesFirst())
+        visited[index] = 2;
+        int numNodeArcs = compiled.arcOffset[index+1] - compiled.arcOffset[index];
+        if (numNodeArcs == 0)
+            costToGo[index] = compiled.nodeCost[index];
+        for (int i=0; i< numNodeArcs; i++)
         {
-            AOnode* father;
-            string nameFather;
-            int numChildren;
-            int hyperarcCost;
-            vector<AOnode*> childNodes;
-            
-            graphFile >>numChildren >>nameFather >>hyperarcCost;
-            if (!graphFile)
-                break;
-            father = findByName(nameFather);
-            //DEBUG:cout<<"nameFather = " <<nameFather <<endl;
-            
-            // the next numChildren lines contain the names of the child nodes
-            for (int i=0; i < numChildren; i++)
+            int arcDeviations;
+            int cost = computeArcCostToGo(*compiled.node[index], i, arcDeviations);
+            if ((i == 0) || (cost < costToGo[index]) ||
+                ((cost == costToGo[index]) && (arcDeviations < deviations[index])))
             {
-                AOnode* temp;
-                string nameChild;
-                graphFile >>nameChild;
-                if (!graphFile)
-                    break;
-                temp = findByName(nameChild);
-                childNodes.push_back(temp);
+                costToGo[index] = cost;
+                deviations[index] = arcDeviations;
             }
-            father->addArc(hyperarcIndex, childNodes, hyperarcCost);
-            hyperarcIndex = hyperarcIndex+1;
         }
-        // identify the head node in the graph
-        head = findByName(headName);
     }
-    graphFile.close();
+    //DEBUG:cout<<"Head cost-to-go: " <<costToGo[head->nId] <<endl;
     
-    // set up the graph (nodes feasibility, paths costs)
-    setupGraph();
+    return true;
 }
 
-//! display graph information
-void AOgraph::printGraphInfo()
+//! compute the cost-to-go of a node through one of its hyperarcs
+//! @param[in] node             reference to the node to use for cost computation
+//! @param[in] hIndex           index of the node's hyperarc to use for cost computation
+//! @param[out] arcDeviations   number of non-first hyperarcs chosen through the hyperarc
+//! @return                     cost-to-go of the node through the hyperarc
+int AOgraph::computeArcCostToGo(AOnode &node, int hIndex, int &arcDeviations)
 {
-    cout<<endl;
-    cout<<"Info of graph: " <<gName <<endl;
-    cout<<"Number of nodes: " <<graph.size() <<endl;
-    cout<<"Head node: " <<head->nName <<endl <<endl;
-    for (int i=0; i< (int)graph.size(); i++)
-        graph[i].printNodeInfo();
-    cout<<endl;
+    int arc = compiled.arcOffset[node.nId] + hIndex;
+    int cost = compiled.nodeCost[node.nId] + compiled.arcCost[arc] - arcBenefit[arc];
+    
+    arcDeviations = (hIndex == 0) ? 0 : 1;
+    for (int c = compiled.childOffset[arc]; c < compiled.childOffset[arc+1]; c++)
+    {
+        int childIndex = compiled.childNode[c];
+        cost = cost + costToGo[childIndex];
+        arcDeviations = arcDeviations + deviations[childIndex];
+    }
+    
+    return cost;
 }
 
-//! suggest the node to solve
-//! @param[in] strategy     "0" = short-sighted, "1" = long-sighted
-//! @return                 name of the suggested node
-string AOgraph::suggestNext(bool strategy)
+//! record the benefit of a solved node on the hyperarcs of its parents
+//! @param[in] solved       reference to the solved node
+void AOgraph::updateArcBenefit(AOnode &solved)
 {
-    // issue a warning if the graph has been solved already
-    if (head->nSolved == true)
-    {
-        cout<<"[WARNING] The graph is solved. No suggestion possible." <<endl;
-        return "end";
-    }
+    // same update rule as updatePaths(): the hyperarc connecting a parent to
+    // the solved node is discounted by toSubtract - hyperarc.hCost
+    int toSubtract = solved.nCost + computeOverallUpdate(solved);
     
-    int optimalPathIndex = 0;
-        
-    // short-sighted strategy:
-    // pick the path which received the highest benefit from the last action
-    if (strategy == false)
+    // N.B. a parent is listed once per hyperarc including the solved node
+    for (int k = compiled.parentOffset[solved.nId]; k < compiled.parentOffset[solved.nId+1]; k++)
     {
-        // find the path with highest benefit from last action
-        for (int i=1; i< (int)pUpdate.size(); i++)
-            if (pUpdate[i] > pUpdate[optimalPathIndex])
-                optimalPathIndex = pIndices[i];
+        if (compiled.isLink(solved.nId, k) == false)
+            continue;
+        int arc = compiled.parentArc[k];
+        arcBenefit[arc] += toSubtract - compiled.arcCost[arc];
     }
-    // long-sighted strategy:
-    // pick the path which minimizes the cost to completion
-    if (strategy == true)
-        optimalPathIndex = findOptimalPath();
-
-    AOnode* suggestion = paths[optimalPathIndex].suggestNode();
-    cout<<"ENDOR suggestion: " <<endl
-        <<"Suggested path = " <<optimalPathIndex <<endl
-        <<"Suggested node = " <<suggestion->nName <<endl;
-    
-    return suggestion->nName;
 }
 
-//! solve a node, finding it by name
-//! @param[in] nameNode    name of the node
-void AOgraph::solveByName(string nameNode)
+//! build the optimal path from the cost-to-go of the nodes
+void AOgraph::buildOptimalPath()
 {
-    AOnode* solved = findByName(nameNode);
-    bool result = solved->setSolved();
-    updateNodeFeasibility();
-    printGraphInfo();
+    optimalPath = Path(0, -1);
+    if (head == NULL)
+        return;
     
-    // report that the graph has been solved if the solved node is the head node
-    if (head->nSolved == true)
+    // expand the nodes in the same order used by generatePaths()
+    optimalPath.addNode(head);
+    for (int i=0; i< (int)optimalPath.pathNodes.size(); i++)
     {
-        cout<<"[REPORT] The graph is solved (head node solved)." <<endl;
-        return;
+        int index = optimalPath.pathNodes[i]->nId;
+        int numNodeArcs = compiled.arcOffset[index+1] - compiled.arcOffset[index];
+        if (numNodeArcs == 0)
+            continue;
+        
+        // among the cheapest hyperarcs with fewest non-first hyperarcs below,
+        // choose the one of the path with the lowest index in generatePaths()
+        int chosen = -1;
+        for (int j=0; j< numNodeArcs; j++)
+        {
+            int arcDeviations;
+            int cost = computeArcCostToGo(*compiled.node[index], j, arcDeviations);
+            if ((cost == costToGo[index]) && (arcDeviations == deviations[index])
+                && ((chosen == -1) || (arcComesFirst(j, chosen) == true)))
+                chosen = j;
+        }
+        int arc = compiled.arcOffset[index] + chosen;
+        optimalPath.pathArcs.push_back(compiled.arcIndex[arc]);
+        for (int c = compiled.childOffset[arc]; c < compiled.childOffset[arc+1]; c++)
+            optimalPath.addNode(compiled.node[compiled.childNode[c]]);
+    }
+    optimalPath.pCost = costToGo[head->nId];
+    optimalPath.pComplete = true;
+    checkSolvedNodes(optimalPath);
+}
+
+//! check the solved nodes of a path built outside generatePaths()
+//! @param[in,out] path     path whose solved nodes are to be checked
+void AOgraph::checkSolvedNodes(Path &path)
+{
+    // as updatePaths() does, a solved node is checked if the path includes
+    // the hyperarc connecting it to one of its parents
+    vector<int> sortedArcs = path.pathArcs;
+    std::sort(sortedArcs.begin(), sortedArcs.end());
+    for (int i=0; i< (int)path.pathNodes.size(); i++)
+    {
+        int index = path.pathNodes[i]->nId;
+        if (path.pathNodes[i]->nSolved == false)
+            continue;
+        for (int k = compiled.parentOffset[index]; k < compiled.parentOffset[index+1]; k++)
+        {
+            if ((compiled.isLink(index, k) == true) &&
+                std::binary_search(sortedArcs.begin(), sortedArcs.end(), compiled.arcIndex[compiled.parentArc[k]]))
+            {
+                path.checkedNodes[i] = true;
+                break;
+            }
+        }
+    }
+}
+
+//! constructor of class AOgraph
+//! @param[in] name 	name of the graph
+//! @param[in] engine 	engine used to identify the optimal path
+AOgraph::AOgraph(string name, PathEngine engine): nameIndex(&graph), optimalPath(0, -1)
+{
+    gName = name;
+    head = NULL;
+    numArcs = 0;
+    gEngine = engine;
+    gThreads = 1;
+    maxPaths = 0.0;
+    maxPathBytes = 0.0;
+    budgetFallback = true;
+    
+    // the events are displayed on the console only if the log level allows it
+#if ENDOR_LOG_LEVEL >= ENDOR_LOG_EVENTS
+    observers.push_back(&textObserver);
+#endif
+    
+    //DEBUG:printGraphInfo();
+}
+
+//! report an error in a graph description, at the position of the last token read
+#define DESCRIPTION_ERROR(reader, text) ENDOR_MESSAGE("[ERROR] " <<fileName <<":" \
+    <<(reader).tokenLine <<":" <<(reader).tokenColumn <<": " <<text)
+
+//! read the nodes and hyperarcs of a graph description
+//! @param[in] fileName    name of the file with the graph description
+//! @return                false if the description is not valid (the graph is left empty)
+bool AOgraph::readDescription(string fileName)
+{
+    DescriptionReader reader;
+    if (reader.open(fileName) == false)
+    {
+        ENDOR_MESSAGE("[ERROR] Unable to open the graph description " <<fileName <<".");
+        return false;
+    }
+    
+    // the first line contains:
+    // 1. the name of the graph
+    // 2. the number N=numNodes of nodes
+    // 3. the name of the head node (corresponding to the final assembly)
+    if (reader.next() == false)
+    {
+        DESCRIPTION_ERROR(reader, "the graph description is empty.");
+        return false;
+    }
+    string name = reader.tokenText();
+    int numNodes;
+    if ((reader.nextInt(numNodes) == false) || (numNodes < 0))
+    {
+        DESCRIPTION_ERROR(reader, "expected the number of nodes after the name of the graph.");
+        return false;
+    }
+    if (reader.next() == false)
+    {
+        DESCRIPTION_ERROR(reader, "expected the name of the head node after the number of nodes.");
+        return false;
+    }
+    string headName = reader.tokenText();
+    // N.B. the positions are only used by the error messages (unused with ENDOR_LOG_LEVEL=0)
+    int headLine = reader.tokenLine;
+    int headColumn = reader.tokenColumn;
+    (void)headLine;
+    (void)headColumn;
+    
+    // all nodes are stored contiguously: their pointers stay valid
+    // N.B. the number of nodes in the header is not checked yet: the space
+    // reserved is bounded by the size of the file (at least 4 bytes per
+    // node, e.g. "a 1\n"), a wrong number is reported while reading the nodes
+    long long maxNodes = reader.fileBytes / 4;
+    int expectedNodes = (numNodes < maxNodes) ? numNodes : (int)maxNodes;
+    graph.reserve(expectedNodes);
+    nameIndex.reserve(expectedNodes);
+    
+    // the next N lines contain the name and cost of all the nodes in the graph
+    bool valid = true;
+    for (int i=0; (i < numNodes) && (valid == true); i++)
+    {
+        valid = false;
+        if (reader.next() == false)
+        {
+            DESCRIPTION_ERROR(reader, "the header declares " <<numNodes <<" nodes, "
+                <<i <<" found.");
+            break;
+        }
+        if (nameIndex.find(reader.token, reader.tokenLength) != -1)
+        {
+            DESCRIPTION_ERROR(reader, "the node " <<reader.tokenText() <<" already exists.");
+            break;
+        }
+        string nameNode = reader.tokenText();
+        int cost;
+        if (reader.nextInt(cost) == false)
+        {
+            DESCRIPTION_ERROR(reader, "expected the cost of node " <<nameNode
+                <<" (the header declares " <<numNodes <<" nodes, " <<i <<" found before it).");
+            break;
+        }
+        AOnode toAdd(nameNode, cost);
+        toAdd.nId = i;
+        graph.push_back(toAdd);
+        nameIndex.insert(i);
+        valid = true;
+    }
+    
+    // the next ?? lines contain the descriptions of the hyperarcs in the graph
+    int hyperarcIndex = 0;
+    vector<AOnode*> childNodes;
+    while (valid == true)
+    {
+        int numChildren;
+        if (reader.nextInt(numChildren) == false)
+        {
+            // the description ends after the last complete hyperarc
+            if (reader.endReached() == true)
+                break;
+            valid = false;
+            DESCRIPTION_ERROR(reader, "expected the number of child nodes of a hyperarc, found "
+                <<reader.tokenText() <<" (do the numbers of nodes and child nodes match?).");
+            break;
+        }
+        if (numChildren < 0)
+        {
+            valid = false;
+            DESCRIPTION_ERROR(reader, "invalid number of child nodes " <<numChildren <<".");
+            break;
+        }
+        int arcLine = reader.tokenLine;
+        int arcColumn = reader.tokenColumn;
+        (void)arcLine;
+        (void)arcColumn;
+        
+        valid = false;
+        if (reader.next() == false)
+        {
+            DESCRIPTION_ERROR(reader, "truncated hyperarc: expected the name of the father node.");
+            break;
+        }
+        int father = nameIndex.find(reader.token, reader.tokenLength);
+        if (father == -1)
+        {
+            DESCRIPTION_ERROR(reader, "unknown node " <<reader.tokenText() <<".");
+            break;
+        }
+        int hyperarcCost;
+        if (reader.nextInt(hyperarcCost) == false)
+        {
+            DESCRIPTION_ERROR(reader, "expected the cost of the hyperarc of node "
+                <<graph[father].nName <<".");
+            break;
+        }
+        
+        // the next numChildren lines contain the names of the child nodes
+        childNodes.clear();
+        for (int i=0; i < numChildren; i++)
+        {
+            if (reader.next() == false)
+            {
+                ENDOR_MESSAGE("[ERROR] " <<fileName <<":" <<arcLine <<":" <<arcColumn
+                    <<": truncated hyperarc of node " <<graph[father].nName <<": "
+                    <<numChildren <<" child nodes declared, " <<i <<" found.");
+                break;
+            }
+            int child = nameIndex.find(reader.token, reader.tokenLength);
+            if (child == -1)
+            {
+                DESCRIPTION_ERROR(reader, "unknown node " <<reader.tokenText() <<".");
+                break;
+            }
+            childNodes.push_back(&graph[child]);
+        }
+        if ((int)childNodes.size() < numChildren)
+            break;
+        
+        graph[father].addArc(hyperarcIndex, childNodes, hyperarcCost);
+        hyperarcIndex = hyperarcIndex+1;
+        valid = true;
+    }
+    
+    // identify the head node in the graph
+    int headId = nameIndex.find(headName);
+    if ((valid == true) && (headId == -1))
+    {
+        valid = false;
+        ENDOR_MESSAGE("[ERROR] " <<fileName <<":" <<headLine <<":" <<headColumn
+            <<": unknown head node " <<headName <<".");
+    }
+    
+    // an invalid description leaves the graph empty
+    if (valid == false)
+    {
+        graph.clear();
+        nameIndex.clear();
+        return false;
+    }
+    
+    gName = name;
+    numArcs = hyperarcIndex;
+    head = &graph[headId];
+    return true;
+}
+
+#undef DESCRIPTION_ERROR
+
+//! set the number of threads generating the paths
+//! N.B. the paths are the same, with the same indices, whatever the number of threads
+//! @param[in] numThreads   number of threads (<= 0 = one per hardware thread)
+void AOgraph::setGenerationThreads(int numThreads)
+{
+    if (numThreads <= 0)
+        numThreads = thread::hardware_concurrency();
+    if (numThreads <= 0)
+        numThreads = 1;
+    gThreads = numThreads;
+}
+
+//! set the budget of the paths engine (checked when the graph is loaded)
+//! @param[in] numPaths     maximum number of paths (<= 0 = no limit)
+//! @param[in] numBytes     maximum bytes held by the paths (<= 0 = no limit)
+//! @param[in] fallback     over budget: true = use the solution graph engine, false = do not load the graph
+void AOgraph::setPathBudget(double numPaths, double numBytes, bool fallback)
+{
+    maxPaths = numPaths;
+    maxPathBytes = numBytes;
+    budgetFallback = fallback;
+}
+
+//! count the paths navigating the graph (without generating them)
+//! @param[out] numPaths    number of paths generatePaths() would generate
+//! @param[out] totalLength overall number of nodes in all paths
+//! @return                 false if the paths are infinite (cycle in the graph)
+bool AOgraph::countPaths(double &numPaths, double &totalLength) const
+{
+    int headId = (head == NULL) ? -1 : head->nId;
+    return compiled.countPaths(headId, numPaths, totalLength);
+}
+
+//! load the graph description from a file
+//! @param[in] fileName    name of the file with the graph description
+void AOgraph::loadFromFile(string fileName)
+{
+    // raise an error if the graph is not empty
+    if (graph.size() != 0)
+    {
+        ENDOR_MESSAGE("[ERROR] The graph is not empty."
+            <<"Do you really want to overwrite the current graph?");
+        return;
+    }            
+    
+    if (readDescription(fileName) == false)
+        return;
+    
+    // compile the hyperarcs, child nodes and parents in flat arrays
+    compiled.build(graph);
+    
+    // set up the graph (nodes feasibility, paths costs)
+    setupGraph();
+}
+
+//! load the graph from a binary image (see compileDescription())
+//! @param[in] fileName    name of the file with the binary image
+void AOgraph::loadFromBinary(string fileName)
+{
+    // raise an error if the graph is not empty
+    if (graph.size() != 0)
+    {
+        ENDOR_MESSAGE("[ERROR] The graph is not empty."
+            <<"Do you really want to overwrite the current graph?");
+        return;
+    }
+    
+    GraphImage image;
+    if (image.open(fileName) == false)
+        return;
+    const ImageHeader &header = *image.header;
+    gName.assign(image.graphName, header.iGraphNameBytes);
+    
+    // create the nodes, with the names interned in the image
+    // N.B. the names in the image are unique: each one is added with a single lookup
+    graph.reserve(header.iNumNodes);
+    nameIndex.reserve(header.iNumNodes);
+    for (int i=0; i< header.iNumNodes; i++)
+    {
+        AOnode toAdd(string(image.names + image.nameOffset[i], image.nameOffset[i+1] - image.nameOffset[i]),
+            image.nodeCost[i]);
+        toAdd.nId = i;
+        graph.push_back(toAdd);
+        if (nameIndex.insert(i) == false)
+        {
+            ENDOR_MESSAGE("[ERROR] The binary image " <<fileName <<" is corrupted.");
+            return;
+        }
+    }
+    
+    // create the hyperarcs of each node
+    vector<AOnode*> childNodes;
+    for (int i=0; i< header.iNumNodes; i++)
+    {
+        for (int a = image.arcOffset[i]; a < image.arcOffset[i+1]; a++)
+        {
+            childNodes.clear();
+            for (int c = image.childOffset[a]; c < image.childOffset[a+1]; c++)
+                childNodes.push_back(&graph[image.childNode[c]]);
+            graph[i].addArc(image.arcIndex[a], childNodes, image.arcCost[a]);
+        }
+    }
+    numArcs = header.iNumArcs;
+    head = (header.iHead == -1) ? NULL : &graph[header.iHead];
+    
+    // the flat arrays are copied from the image, not compiled again
+    compiled.load(image, graph);
+    
+    // set up the graph (nodes feasibility, paths costs)
+    setupGraph();
+}
+
+//! compile a graph description into a binary image
+//! @param[in] textFile     name of the file with the graph description
+//! @param[in] binaryFile   name of the file to write the binary image to
+//! @return                 true if the binary image is written
+bool AOgraph::compileDescription(string textFile, string binaryFile)
+{
+    // the nodes and hyperarcs are read, without setting up the graph
+    AOgraph description(textFile);
+    if (description.readDescription(textFile) == false)
+        return false;
+    description.compiled.build(description.graph);
+    
+    int headId = (description.head == NULL) ? -1 : description.head->nId;
+    return GraphImage::write(binaryFile, description.gName, headId, description.compiled);
+}
+
+//! display graph information
+void AOgraph::printGraphInfo()
+{
+    cout<<endl;
+    cout<<"Info of graph: " <<gName <<endl;
+    cout<<"Number of nodes: " <<graph.size() <<endl;
+    cout<<"Head node: " <<head->nName <<endl <<endl;
+    for (int i=0; i< (int)graph.size(); i++)
+        graph[i].printNodeInfo();
+    cout<<endl;
+}
+
+//! add an observer of the events of the graph
+//! @param[in] observer     pointer to the observer (not owned by the graph)
+void AOgraph::addObserver(AOobserver* observer)
+{
+    if (std::find(observers.begin(), observers.end(), observer) == observers.end())
+        observers.push_back(observer);
+}
+
+//! remove an observer of the events of the graph
+//! @param[in] observer     pointer to the observer
+void AOgraph::removeObserver(AOobserver* observer)
+{
+    observers.erase(std::remove(observers.begin(), observers.end(), observer), observers.end());
+}
+
+//! suggest the node to solve
+//! @param[in] strategy     "0" = short-sighted, "1" = long-sighted
+//! @return                 name of the suggested node
+string AOgraph::suggestNext(bool strategy)
+{
+    // raise an error if there is no graph
+    if (head == NULL)
+    {
+        ENDOR_MESSAGE("[WARNING] There is no graph to navigate (head == NULL).");
+        return "";
+    }
+    
+    // issue a warning if the graph has been solved already
+    if (head->nSolved == true)
+    {
+        ENDOR_MESSAGE("[WARNING] The graph is solved. No suggestion possible.");
+        return "end";
+    }
+    
+    // solution graph engine: there are no paths, only the optimal one
+    if (gEngine == ENGINE_SOLUTION_GRAPH)
+    {
+        if (strategy == false)
+            ENDOR_MESSAGE("[WARNING] The solution graph engine does not keep the benefit of each path. "
+                <<"Using the long-sighted strategy.");
+        buildOptimalPath();
+        
+        AOnode* suggestion = optimalPath.suggestNode();
+        for (int i=0; i< (int)observers.size(); i++)
+            observers[i]->onSuggestionMade(*this, optimalPath, suggestion, true);
+        if (suggestion == NULL)
+            return "";
+        
+        return suggestion->nName;
+    }
+    
+    int optimalPathIndex = 0;
+        
+    // short-sighted strategy:
+    // pick the path which received the highest benefit from the last action
+    if (strategy == false)
+        optimalPathIndex = findShortSightedPath(pIndices, pUpdate);
+    // long-sighted strategy:
+    // pick the path which minimizes the cost to completion
+    if (strategy == true)
+        optimalPathIndex = findOptimalPath();
+    if ((optimalPathIndex < 0) || (optimalPathIndex >= paths.size()))
+        return "";
+
+    Path suggestedPath = paths[optimalPathIndex];
+    AOnode* suggestion = suggestedPath.suggestNode();
+    for (int i=0; i< (int)observers.size(); i++)
+        observers[i]->onSuggestionMade(*this, suggestedPath, suggestion, strategy);
+    if (suggestion == NULL)
+        return "";
+    
+    return suggestion->nName;
+}
+
+//! suggest the node to solve by Monte Carlo rollouts of the completions (rollout strategy)
+//! N.B. each feasible node is scored by the average cost of solving it, then
+//! completing the graph with random or greedy choices (see RolloutPlanner):
+//! unlike the other strategies, the interactions of the remaining choices count
+//! @param[in] numRollouts  number of rollouts, shared by the feasible nodes (at least one each)
+//! @param[in] numThreads   number of threads running the rollouts
+//! @param[in] exploration  probability of a random hyperarc in a rollout (0 = greedy only)
+//! @param[in] seed         seed of the random choices (same seed = same suggestion)
+//! @return                 name of the suggested node
+string AOgraph::suggestByRollouts(int numRollouts, int numThreads, double exploration, unsigned int seed)
+{
+    // issue a warning if the graph has been solved already
+    if (head->nSolved == true)
+    {
+        ENDOR_MESSAGE("[WARNING] The graph is solved. No suggestion possible.");
+        return "end";
+    }
+    
+    RolloutPlanner planner(&compiled, head->nId, exploration);
+    int suggestion = planner.suggest(numRollouts, numThreads, seed);
+    vector<AOnode*> candidates;
+    for (int i=0; i< (int)planner.candidates.size(); i++)
+        candidates.push_back(compiled.node[planner.candidates[i]]);
+    AOnode* node = (suggestion == -1) ? NULL : compiled.node[suggestion];
+    for (int i=0; i< (int)observers.size(); i++)
+        observers[i]->onRolloutsFinished(*this, candidates, planner.scores, node);
+    
+    if (node == NULL)
+    {
+        ENDOR_MESSAGE("[ERROR] No suggestion possible.");
+        return "";
+    }
+    return node->nName;
+}
+
+//! solve a node, finding it by name
+//! @param[in] nameNode    name of the node
+void AOgraph::solveByName(string nameNode)
+{
+    AOnode* solved = findByName(nameNode);
+    if (solved == NULL)
+        return;
+    
+    solveById(solved->nId);
+}
+
+//! solve a node, finding it by identifier
+//! @param[in] idNode      identifier of the node
+void AOgraph::solveById(int idNode)
+{
+    // raise an error if the identifier is out of bounds
+    if ((idNode < 0) || (idNode >= (int)graph.size()))
+    {
+        ENDOR_MESSAGE("[ERROR] The graph has only " <<graph.size() <<" nodes. "
+            <<"Node identifier " <<idNode <<" does not exist.");
+        return;
+    }
+    
+    AOnode* solved = &graph[idNode];
+    bool result = solved->setSolved();
+    if (result == true)
+        updateParentsFeasibility(*solved);
+    for (int i=0; i< (int)observers.size(); i++)
+        observers[i]->onNodeSolved(*this, *solved);
+    
+    // report that the graph has been solved if the solved node is the head node
+    if (head->nSolved == true)
+    {
+        ENDOR_MESSAGE("[REPORT] The graph is solved (head node solved).");
+        return;
     }
     
     // update the path information (cost) of all paths
     if (result == true)
-        updatePaths(*solved);
-    cout<<endl <<"Updated paths: " <<endl;
-    for(int i=0; i< (int)pUpdate.size(); i++)
-        cout<<"Path index: " <<pIndices[i] <<" - Benefit: " <<pUpdate[i] <<endl;
+    {
+        updateArcBenefit(*solved);
+        if (gEngine == ENGINE_SOLUTION_GRAPH)
+            computeSolutionGraph();
+        else
+            updatePaths(*solved);
+    }
+    for (int i=0; i< (int)observers.size(); i++)
+        observers[i]->onUpdateFinished(*this);
+}
+
+//! solve several nodes at once, finding them by name
+//! N.B. the nodes are validated in the given order, as solveByName() would do
+//! one node at a time (a node is feasible if the nodes before it make it so):
+//! the updates of the paths are merged, each updated path once
+//! @param[in] namesNodes   names of the nodes, in the order they have been solved
+//! @return                 number of nodes solved (the others were not feasible, or already solved)
+int AOgraph::solveMany(const vector<string> &namesNodes)
+{
+    // 1. solve the nodes, updating the feasibility of their parents only
+    // 2. collect the updates of the paths of the nodes which update them
+    //    (solved, and the head node not solved yet)
+    vector<AOnode*> solvedNodes;
+    vector<AOnode*> updating;
+    vector< pair<int, int> > subtracted;
+    vector<int> updateStart;
+    vector<int> indices;
+    vector<int> updates;
+    vector<int> subtracts;
+    bool pendingGraph = false;
+    for (int i=0; i< (int)namesNodes.size(); i++)
+    {
+        AOnode* solved = findByName(namesNodes[i]);
+        if (solved == NULL)
+            continue;
+        
+        // N.B. the solution graph is computed in the state of the last update,
+        // i.e. before the head node is solved
+        if ((solved == head) && (pendingGraph == true))
+        {
+            computeSolutionGraph();
+            pendingGraph = false;
+        }
+        
+        bool result = solved->setSolved();
+        if (result == true)
+        {
+            updateParentsFeasibility(*solved);
+            solvedNodes.push_back(solved);
+        }
+        
+        // report that the graph has been solved if the solved node is the head node
+        if (head->nSolved == true)
+        {
+            ENDOR_MESSAGE("[REPORT] The graph is solved (head node solved).");
+            continue;
+        }
+        if (result == false)
+            continue;
+        
+        updateArcBenefit(*solved);
+        if (gEngine == ENGINE_SOLUTION_GRAPH)
+        {
+            pendingGraph = true;
+            continue;
+        }
+        int lookups = computePathUpdates(*solved, indices, updates, subtracts);
+        ENDOR_COUNT(stats.arcLookups, lookups);
+        updateStart.push_back((int)subtracted.size());
+        for (int j=0; j< (int)indices.size(); j++)
+            subtracted.push_back(make_pair(indices[j], subtracts[j]));
+        
+        // the paths updated by the last solved node are the ones kept
+        updating.push_back(solved);
+        pIndices.swap(indices);
+        pUpdate.swap(updates);
+    }
+    updateStart.push_back((int)subtracted.size());
+    if (solvedNodes.empty() == false)
+        for (int i=0; i< (int)observers.size(); i++)
+            observers[i]->onBatchSolved(*this, solvedNodes);
+    
+    // update the solution graph once
+    if (pendingGraph == true)
+        computeSolutionGraph();
+    
+    // check the solved nodes in the updated paths, in the order they have been solved
+    for (int i=0; i< (int)updating.size(); i++)
+        for (int j = updateStart[i]; j < updateStart[i+1]; j++)
+            paths.checkNode(subtracted[j].first, updating[i]);
+    
+    // merge the costs subtracted to each path, then update all paths at once
+    std::sort(subtracted.begin(), subtracted.end());
+    indices.clear();
+    subtracts.clear();
+    for (int i=0; i< (int)subtracted.size(); i++)
+    {
+        if (indices.empty() || (indices.back() != subtracted[i].first))
+        {
+            indices.push_back(subtracted[i].first);
+            subtracts.push_back(0);
+        }
+        subtracts.back() += subtracted[i].second;
+    }
+    paths.subtractCosts(indices, subtracts);
+    for (int i=0; i < (int)indices.size(); i++)
+        for (int k=0; k< (int)observers.size(); k++)
+            observers[k]->onPathUpdated(*this, indices[i], paths.costs[indices[i]]);
+    
+    if ((solvedNodes.empty() == false) && (head->nSolved == false))
+        for (int i=0; i< (int)observers.size(); i++)
+            observers[i]->onUpdateFinished(*this);
+    
+    return solvedNodes.size();
+}
+
+//! add a cost to the paths including a node (or hyperarc), once per occurrence
+//! N.B. only these paths are updated, each in time proportional to the
+//! logarithm of the number of paths (see PathStore::updateTree())
+//! @param[in] occurrences  paths including the node (or hyperarc), with the number of occurrences
+//! @param[in] delta        cost to add for each occurrence (new cost - old cost)
+void AOgraph::changePathCosts(const vector<PathOccurrence> &occurrences, int delta)
+{
+    vector<int> indices;
+    vector<int> amounts;
+    for (int i=0; i< (int)occurrences.size(); i++)
+    {
+        indices.push_back(occurrences[i].oPath);
+        amounts.push_back(-delta*occurrences[i].oCount);
+    }
+    paths.subtractCosts(indices, amounts);
+    for (int i=0; i < (int)indices.size(); i++)
+        for (int k=0; k< (int)observers.size(); k++)
+            observers[k]->onPathUpdated(*this, indices[i], paths.costs[indices[i]]);
+}
+
+//! change the cost of a node not solved yet, updating the paths including it
+//! N.B. the cost of the paths including the node changes once per occurrence
+//! of the node; the solution graph engine computes the cost-to-go again
+//! @param[in] nameNode     name of the node
+//! @param[in] cost         new cost of the node
+//! @return                 true if the cost has changed
+bool AOgraph::setNodeCost(string nameNode, int cost)
+{
+    AOnode* node = findByName(nameNode);
+    if (node == NULL)
+        return false;
+    
+    // raise an error if the node is solved (its cost has been paid already)
+    if (node->nSolved == true)
+    {
+        ENDOR_MESSAGE("[ERROR] The node " <<nameNode <<" is solved. Its cost cannot change.");
+        return false;
+    }
+    
+    int delta = cost - node->nCost;
+    node->nCost = cost;
+    compiled.nodeCost[node->nId] = cost;
+    if (delta == 0)
+        return true;
+    
+    if (gEngine == ENGINE_SOLUTION_GRAPH)
+        computeSolutionGraph();
+    else if (node->nId < (int)paths.nodePaths.size())
+        changePathCosts(paths.nodePaths[node->nId], delta);
+    return true;
+}
+
+//! change the cost of a hyperarc of a node not solved yet, updating the paths including it
+//! N.B. the costs subtracted from the paths when the child nodes of the
+//! hyperarc have been solved are not computed again
+//! @param[in] nameNode     name of the node
+//! @param[in] hIndex       index of the node's hyperarc
+//! @param[in] cost         new cost of the hyperarc
+//! @return                 true if the cost has changed
+bool AOgraph::setArcCost(string nameNode, int hIndex, int cost)
+{
+    AOnode* node = findByName(nameNode);
+    if (node == NULL)
+        return false;
+    
+    // raise an error if the hyperarc index is out of bounds, or the node is solved
+    if ((hIndex < 0) || (hIndex >= (int)node->arcs.size()))
+    {
+        ENDOR_MESSAGE("[ERROR] The node has only " <<node->arcs.size() <<" hyperarcs."
+            <<"Hyperarc index " <<hIndex <<" does not exist.");
+        return false;
+    }
+    if (node->nSolved == true)
+    {
+        ENDOR_MESSAGE("[ERROR] The node " <<nameNode <<" is solved. The cost of its hyperarcs cannot change.");
+        return false;
+    }
+    
+    int arc = compiled.arcOffset[node->nId] + hIndex;
+    int delta = cost - node->arcs[hIndex].hCost;
+    node->arcs[hIndex].hCost = cost;
+    compiled.arcCost[arc] = cost;
+    if (delta == 0)
+        return true;
+    
+    if (gEngine == ENGINE_SOLUTION_GRAPH)
+        computeSolutionGraph();
+    else if (compiled.arcIndex[arc] < (int)paths.arcPaths.size())
+        changePathCosts(paths.arcPaths[compiled.arcIndex[arc]], delta);
+    return true;
+}
+
+//! find the feasible nodes not solved yet
+//! @return     nodes which can be solved now, in identifier order
+vector<AOnode*> AOgraph::getFrontier()
+{
+    vector<AOnode*> nodes;
+    for (set<int>::iterator it = frontier.begin(); it != frontier.end(); it++)
+        nodes.push_back(&graph[*it]);
+    
+    return nodes;
+}
+
+//! find the k best paths, in increasing cost order (without generating all paths)
+//! @param[in] k    number of paths to find
+//! @return         best paths (fewer than k if the graph has fewer paths)
+vector<Path> AOgraph::findBestPaths(int k)
+{
+    vector<Path> best;
+    PathIterator iterator(*this);
+    Path path(0, 0);
+    
+    while (((int)best.size() < k) && (iterator.next(path) == true))
+        best.push_back(path);
+    
+    return best;
+}
+
+//! determine whether a hyperarc comes first among the equally good ones of a node
+//! N.B. tie rule shared by findOptimalPath(), the solution graph engine and
+//! the path iterator: the path with the lowest index in generatePaths() comes
+//! first among the paths with the same cost. As the copies of a path are
+//! indexed after it, in the order of its nodes and hyperarcs:
+//! 1. the paths with fewer non-first hyperarcs come first
+//! 2. then, at the first node (in the order of the nodes of the paths) where
+//!    the hyperarcs differ, the path with a non-first hyperarc comes first (it
+//!    was copied before the other one chose a non-first hyperarc), the one
+//!    with the lower hyperarc if both are
+//! @param[in] hIndex   index of the hyperarc in the node
+//! @param[in] other    index of another hyperarc of the same node
+//! @return             true if the paths through hIndex come first (rule 2)
+bool AOgraph::arcComesFirst(int hIndex, int other)
+{
+    if ((hIndex == 0) || (other == 0))
+        return (hIndex != 0) && (other == 0);
+    
+    return hIndex < other;
+}
+
+//! append integers to a binary blob
+//! @param[out] blob    binary blob
+//! @param[in] values   integers to append
+//! @param[in] count    number of integers
+static void appendInts(vector<char> &blob, const int* values, int count)
+{
+    if (count == 0)
+        return;
+    size_t offset = blob.size();
+    blob.resize(offset + count*sizeof(int));
+    memcpy(&blob[offset], values, count*sizeof(int));
+}
+
+//! read integers from a binary blob
+//! @param[in] blob         binary blob
+//! @param[in,out] offset   first byte to read (moved after the integers)
+//! @param[out] values      integers read
+//! @param[in] count        number of integers
+static void readInts(const vector<char> &blob, size_t &offset, vector<int> &values, int count)
+{
+    values.resize(count);
+    if (count > 0)
+        memcpy(&values[0], &blob[offset], count*sizeof(int));
+    offset = offset + count*sizeof(int);
+}
+
+//! append a variable-length integer (7 bits per byte) to a binary blob
+//! @param[out] blob    binary blob
+//! @param[in] value    integer to append (signed values are zigzag-encoded)
+static void appendVarint(vector<char> &blob, int value)
+{
+    unsigned int bits = ((unsigned int)value << 1) ^ (unsigned int)(value >> 31);
+    while (bits >= 0x80)
+    {
+        blob.push_back((char)((bits & 0x7F) | 0x80));
+        bits = bits >> 7;
+    }
+    blob.push_back((char)bits);
+}
+
+//! read a variable-length integer from a binary blob
+//! @param[in,out] data     first byte to read (moved after the integer)
+//! @param[in] end          end of the bytes to read
+//! @param[out] value       integer read
+//! @return                 false if the integer is truncated or too long
+static bool readVarint(const char* &data, const char* end, int &value)
+{
+    unsigned int bits = 0;
+    for (int shift = 0; shift < 35; shift = shift + 7)
+    {
+        if (data == end)
+            return false;
+        unsigned char byte = (unsigned char)*data;
+        data++;
+        bits = bits | ((unsigned int)(byte & 0x7F) << shift);
+        if ((byte & 0x80) == 0)
+        {
+            value = (int)(bits >> 1) ^ -(int)(bits & 1);
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+//! determine whether integers are in a given range
+//! @param[in] values   integers to check
+//! @param[in] first    first value in range
+//! @param[in] limit    first value out of range
+//! @return             true if all integers are in [first, limit)
+static bool inRange(const vector<int> &values, int first, int limit)
+{
+    for (int i=0; i< (int)values.size(); i++)
+        if ((values[i] < first) || (values[i] >= limit))
+            return false;
+    
+    return true;
+}
+
+//! save the solve state (solved nodes, feasibility, path costs) in a binary blob
+//! N.B. the description of the graph is not saved: the state is restored on
+//! the same graph, loaded again from its description or binary image
+//! @param[out] state   binary blob with the solve state
+void AOgraph::saveState(vector<char> &state)
+{
+    // the solved and feasible nodes are saved as bitsets
+    int numWords = ((int)graph.size() + 31) / 32;
+    vector<int> solvedBits(numWords, 0);
+    vector<int> feasibleBits(numWords, 0);
+    for (int i=0; i< (int)graph.size(); i++)
+    {
+        if (graph[i].nSolved == true)
+            solvedBits[i/32] |= 1u << (i%32);
+        if (graph[i].nFeasible == true)
+            feasibleBits[i/32] |= 1u << (i%32);
+    }
+    
+    // only the hyperarcs which benefitted from solved nodes are saved
+    vector<int> benefitArcs;
+    vector<int> benefits;
+    for (int i=0; i< (int)arcBenefit.size(); i++)
+    {
+        if (arcBenefit[i] == 0)
+            continue;
+        benefitArcs.push_back(i);
+        benefits.push_back(arcBenefit[i]);
+    }
+    
+    // the checks of the same solved node are consecutive, in increasing path order
+    // N.B. the previous check of each path is not saved: the checks are made
+    // in this order, hence it is the last check of the same path
+    vector<int> checkPath(paths.checks.size());
+    for (int i=0; i< paths.size(); i++)
+        for (int c = paths.entries[i].eChecked; c != -1; c = paths.checks[c].cPrevious)
+            checkPath[c] = i;
+    vector<char> checkBytes;
+    int first = 0;
+    while (first < (int)paths.checks.size())
+    {
+        int last = first + 1;
+        while ((last < (int)paths.checks.size()) && (paths.checks[last].cNode == paths.checks[first].cNode))
+            last++;
+        appendVarint(checkBytes, paths.checks[first].cNode->nId);
+        appendVarint(checkBytes, last - first);
+        int previousPath = 0;
+        for (int c = first; c < last; c++)
+        {
+            appendVarint(checkBytes, checkPath[c] - previousPath);
+            previousPath = checkPath[c];
+        }
+        first = last;
+    }
+    
+    // the paths are saved through their costs and checked nodes (not their steps)
+    StateHeader header;
+    memcpy(header.sMagic, STATE_MAGIC, sizeof(header.sMagic));
+    header.sVersion = STATE_VERSION;
+    header.sEngine = gEngine;
+    header.sNumNodes = graph.size();
+    header.sNumArcs = compiled.numArcs();
+    header.sNumPaths = paths.size();
+    header.sNumSteps = paths.steps.size();
+    header.sNumBenefits = benefits.size();
+    header.sNumUpdated = pIndices.size();
+    header.sNumChecks = paths.checks.size();
+    header.sCheckBytes = checkBytes.size();
+    
+    state.assign((const char*)&header, (const char*)&header + sizeof(StateHeader));
+    appendInts(state, solvedBits.data(), numWords);
+    appendInts(state, feasibleBits.data(), numWords);
+    appendInts(state, paths.costs.data(), paths.size());
+    appendInts(state, benefitArcs.data(), benefitArcs.size());
+    appendInts(state, benefits.data(), benefits.size());
+    appendInts(state, pIndices.data(), pIndices.size());
+    appendInts(state, pUpdate.data(), pUpdate.size());
+    state.insert(state.end(), checkBytes.begin(), checkBytes.end());
+    state.resize((state.size() + 3) & ~(size_t)3, 0);
+}
+
+//! restore a solve state saved by saveState() for the same graph
+//! N.B. the paths are not generated again: only their costs and checked nodes change
+//! @param[in] state    binary blob with the solve state
+//! @return             false if the state does not belong to the graph (the graph is unchanged)
+bool AOgraph::restoreState(const vector<char> &state)
+{
+    // raise an error if the state does not match the graph
+    StateHeader header;
+    if (state.size() < sizeof(StateHeader))
+    {
+        ENDOR_MESSAGE("[ERROR] The solve state is corrupted.");
+        return false;
+    }
+    memcpy(&header, &state[0], sizeof(StateHeader));
+    if ((memcmp(header.sMagic, STATE_MAGIC, sizeof(header.sMagic)) != 0)
+        || (header.sVersion != STATE_VERSION))
+    {
+        ENDOR_MESSAGE("[ERROR] The blob is not a solve state of version " <<STATE_VERSION <<".");
+        return false;
+    }
+    if ((header.sEngine != gEngine) || (header.sNumNodes != (int)graph.size())
+        || (header.sNumArcs != compiled.numArcs()) || (header.sNumPaths != paths.size())
+        || (header.sNumSteps != (int)paths.steps.size()))
+    {
+        ENDOR_MESSAGE("[ERROR] The solve state does not belong to graph " <<gName <<".");
+        return false;
+    }
+    
+    // the counts are checked before sizing anything on them: each benefit is
+    // for a distinct hyperarc, each update for a distinct path and each check
+    // takes at least one byte of the checks section
+    if ((header.sNumBenefits < 0) || (header.sNumBenefits > header.sNumArcs)
+        || (header.sNumUpdated < 0) || (header.sNumUpdated > header.sNumPaths)
+        || (header.sCheckBytes < 0) || (header.sNumChecks < 0)
+        || (header.sNumChecks > header.sCheckBytes))
+    {
+        ENDOR_MESSAGE("[ERROR] The solve state is corrupted.");
+        return false;
+    }
+    int numWords = (header.sNumNodes + 31) / 32;
+    size_t intBytes = sizeof(int)*((size_t)2*numWords + header.sNumPaths
+        + 2*(size_t)header.sNumBenefits + 2*(size_t)header.sNumUpdated);
+    if (state.size() != sizeof(StateHeader) + intBytes + ((header.sCheckBytes + (size_t)3) & ~(size_t)3))
+    {
+        ENDOR_MESSAGE("[ERROR] The solve state is corrupted.");
+        return false;
+    }
+    
+    size_t offset = sizeof(StateHeader);
+    vector<int> solvedBits, feasibleBits, costs, benefitArcs, benefits, updated, updates;
+    readInts(state, offset, solvedBits, numWords);
+    readInts(state, offset, feasibleBits, numWords);
+    readInts(state, offset, costs, header.sNumPaths);
+    readInts(state, offset, benefitArcs, header.sNumBenefits);
+    readInts(state, offset, benefits, header.sNumBenefits);
+    readInts(state, offset, updated, header.sNumUpdated);
+    readInts(state, offset, updates, header.sNumUpdated);
+    
+    // the checks are decoded before changing the graph
+    // N.B. the previous check of a path is the last check made in the same path
+    vector<PathCheck> checks;
+    checks.reserve(header.sNumChecks);
+    vector<int> lastChecked(header.sNumPaths, -1);
+    const char* data = state.data() + offset;
+    const char* end = data + header.sCheckBytes;
+    bool valid = inRange(benefitArcs, 0, header.sNumArcs) && inRange(updated, 0, header.sNumPaths);
+    while ((valid == true) && (data != end))
+    {
+        int node, count;
+        valid = readVarint(data, end, node) && readVarint(data, end, count)
+            && (node >= 0) && (node < header.sNumNodes) && (count > 0)
+            && (count <= header.sNumChecks - (int)checks.size());
+        int path = 0;
+        for (int i=0; (i< count) && (valid == true); i++)
+        {
+            int difference;
+            valid = readVarint(data, end, difference);
+            path = path + difference;
+            if ((valid == false) || (path < 0) || (path >= header.sNumPaths))
+            {
+                valid = false;
+                break;
+            }
+            checks.push_back(PathCheck(lastChecked[path], &graph[node]));
+            lastChecked[path] = (int)checks.size()-1;
+        }
+    }
+    if ((valid == false) || ((int)checks.size() != header.sNumChecks))
+    {
+        ENDOR_MESSAGE("[ERROR] The solve state is corrupted.");
+        return false;
+    }
+    
+    // restore the solved and feasible nodes, then the counters of the hyperarcs
+    for (int i=0; i< (int)graph.size(); i++)
+    {
+        graph[i].nSolved = ((solvedBits[i/32] >> (i%32)) & 1) == 1;
+        graph[i].nFeasible = ((feasibleBits[i/32] >> (i%32)) & 1) == 1;
+    }
+    updateNodeFeasibility();
+    
+    arcBenefit.assign(compiled.numArcs(), 0);
+    for (int i=0; i< header.sNumBenefits; i++)
+        arcBenefit[benefitArcs[i]] = benefits[i];
+    
+    // restore the costs and checked nodes of the paths
+    paths.checks.swap(checks);
+    paths.costs = costs;
+    paths.resetCheapest();
+    for (int i=0; i< header.sNumPaths; i++)
+        paths.entries[i].eChecked = lastChecked[i];
+    pIndices = updated;
+    pUpdate = updates;
+    
+    // the solution graph engine computes the cost-to-go again
+    if (gEngine == ENGINE_SOLUTION_GRAPH)
+        computeSolutionGraph();
+    
+    return true;
+}
+
+//! get the statistics of the phases since the last reset
+//! N.B. the bytes held by the paths are the current ones, not accumulated
+//! @return     timings and counters (all zero if compiled with ENDOR_STATS=0)
+GraphStats AOgraph::getStats()
+{
+    GraphStats current = stats;
+#if ENDOR_STATS
+    current.pathBytes = paths.memoryUsage();
+#endif
+    
+    return current;
+}
+
+//! set the statistics of the phases to zero
+void AOgraph::resetStats()
+{
+    stats.reset();
 }
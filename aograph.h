@@ -10,50 +10,38 @@
 
 #include <algorithm>
 #include <fstream>
+#include <set>
 
-#include "aonode.h"
+#include "graphimage.h"
+#include "graphstats.h"
+#include "nameindex.h"
+#include "nodearena.h"
+#include "pathstore.h"
+#include "solvestate.h"
 
 using namespace std;
 
-//! class "Path" for each unique path traversing the graph from the head to the leaves
-class Path
-{        
-    public:
-        int pIndex;                 //!< index of the path
-        int pCost;                  //!< overall cost of all the nodes in the path
-        bool pComplete;             //!< complete: the path fully traverses the graph
-        vector<AOnode*> pathNodes;  //!< set of the nodes in the path
-        vector<int> pathArcs;       //!< set of the hyperarcs in the path
-        vector<bool> checkedNodes;  //!< checked: the node has been analysed
-        
-        //! constructor
-		Path(int cost, int index);
-        
-        //! copy constructor
-        Path(const Path &toBeCopied, int index);
-        
-        //! display path information
-        void printPathInfo();
-        
-        //! add a node in the path
-        void addNode(AOnode* node);
-        
-        //! update the path information (when a node is solved)
-        void updatePath(string nameNode, int cost);
-        
-        //! find the feasible node to suggest
-        AOnode* suggestNode();
-        
-        //! destructor
-		~Path()
-		{
-			//DEBUG:cout<<endl <<"Destroying Path object" <<endl;
-		}		
+//! engines available to identify the optimal path in the graph
+enum PathEngine
+{
+    ENGINE_PATHS,           //!< enumerate all paths, then pick the cheapest one
+    ENGINE_SOLUTION_GRAPH   //!< compute the minimum-cost solution graph bottom-up (no enumeration)
 };
 
+// empty declarations (required by AOgraph)
+class PathIterator;
+class Session;
+class StateDelta;
+class StateOverlay;
+
 //! class "AOgraph" for the AND-OR graph
 class AOgraph
 {    
+    friend class PathIterator;
+    friend class Session;
+    friend class StateDelta;
+    friend class StateOverlay;
+    
     protected:
         //** GRAPH INITIALIZATION **//
         //! add a node in the graph
@@ -64,6 +52,9 @@ class AOgraph
         
         //! update the feasibility status of the nodes in the graph
         void updateNodeFeasibility();
+        
+        //! update the feasibility status of the parents of a solved node
+        void updateParentsFeasibility(AOnode &solved);
 		
         //! compute the cost to add to a path
         int computeAddCost(AOnode &node, int hIndex);
@@ -71,6 +62,15 @@ class AOgraph
         //! generate all possible paths navigating the graph
         void generatePaths();
         
+        //! read the nodes and hyperarcs of a graph description
+        bool readDescription(string fileName);
+        
+        //! determine whether the paths fit in the budget (before generating them)
+        bool checkPathBudget();
+        
+        //! leave the graph empty (as an invalid description would)
+        void clearGraph();
+        
         //! set up a graph
         void setupGraph();
         
@@ -79,37 +79,143 @@ class AOgraph
         HyperArc* findHyperarc(AOnode &parent, AOnode &child);
         
         //! compute the overall update cost (intermediate step to update the path cost)
-        int computeOverallUpdate(AOnode &node);
+        int computeOverallUpdate(const AOnode &node) const;
+        
+        //! compute the updates of the paths when a node is solved (without applying them)
+        int computePathUpdates(const AOnode &solved, vector<int> &indices,
+            vector<int> &updates, vector<int> &subtracts) const;
         
         //! update all paths (update path costs when a node is solved)
         void updatePaths(AOnode &solved);
         
         //! find the optimal path (long-sighted strategy)
         int findOptimalPath();
+        
+        //! find the path with highest benefit from the last solved node (short-sighted strategy)
+        static int findShortSightedPath(const vector<int> &indices, const vector<int> &updates);
+        
+        //** SOLUTION GRAPH ENGINE **//
+        //! compute the cost-to-go of all nodes reachable from the head node
+        bool computeSolutionGraph();
+        
+        //! compute the cost-to-go of a node through one of its hyperarcs
+        int computeArcCostToGo(AOnode &node, int hIndex, int &deviations);
+        
+        //! build the optimal path from the cost-to-go of the nodes
+        void buildOptimalPath();
+        
+        //** PATHS BUILT ON DEMAND **//
+        //! record the benefit of a solved node on the hyperarcs of its parents
+        void updateArcBenefit(AOnode &solved);
+        
+        //! check the solved nodes of a path built outside generatePaths()
+        void checkSolvedNodes(Path &path);
+        
+        //** COST CHANGES **//
+        //! add a cost to the paths including a node (or hyperarc), once per occurrence
+        void changePathCosts(const vector<PathOccurrence> &occurrences, int delta);
     
     public:
         string gName;           //!< name of the graph
-        vector<AOnode> graph;   //!< set of nodes in the AND-OR graph
+        NodeArena graph;        //!< set of nodes in the AND-OR graph (stable storage)
+        NameIndex nameIndex;    //!< identifier of each node, by name
+        CompiledGraph compiled; //!< read-only compiled form of the graph (flat arrays)
+        int numArcs;            //!< number of hyperarcs in the graph
+        set<int> frontier;      //!< identifiers of the feasible nodes not solved yet
+        vector<int> arcUnsolved;    //!< number of distinct child nodes not solved yet, for each compiled hyperarc
         AOnode* head;           //!< pointer to the node = final assembly
-        vector<Path> paths;     //!< set of paths in the AND-OR graph
+        PathStore paths;        //!< set of paths in the AND-OR graph
         vector<int> pIndices;   //!< indices of the updated paths
         vector<int> pUpdate;    //!< costs subtracted to the updated paths
+        PathEngine gEngine;     //!< engine used to identify the optimal path
+        int gThreads;           //!< number of threads generating the paths (1 = no pool)
+        double maxPaths;        //!< maximum number of paths to generate (0 = no limit)
+        double maxPathBytes;    //!< maximum bytes held by the paths (0 = no limit)
+        bool budgetFallback;    //!< over budget: use the solution graph engine (false = fail loading)
+        vector<int> costToGo;   //!< [solution graph] minimum cost to solve each node
+        vector<int> deviations; //!< [solution graph] non-first hyperarcs chosen below each node
+        vector<int> arcBenefit; //!< costs subtracted to each compiled hyperarc by solved nodes
+        Path optimalPath;       //!< [solution graph] optimal path, built from the cost-to-go
+        vector<AOobserver*> observers;  //!< observers notified of the events of the graph
+        TextObserver textObserver;      //!< observer displaying the events (if ENDOR_LOG_LEVEL >= ENDOR_LOG_EVENTS)
+        GraphStats stats;       //!< timings and counters of the phases (if ENDOR_STATS is 1)
         
         //! constructor
-		AOgraph(string name);
+		AOgraph(string name, PathEngine engine = ENGINE_PATHS);
+        
+        //! set the number of threads generating the paths
+        void setGenerationThreads(int numThreads);
+        
+        //! set the budget of the paths engine (checked when the graph is loaded)
+        void setPathBudget(double numPaths, double numBytes, bool fallback);
+        
+        //! count the paths navigating the graph (without generating them)
+        bool countPaths(double &numPaths, double &totalLength) const;
         
         //! load the graph description from a file
         void loadFromFile(string fileName);
         
+        //! load the graph from a binary image (see compileDescription())
+        void loadFromBinary(string fileName);
+        
+        //! compile a graph description into a binary image
+        static bool compileDescription(string textFile, string binaryFile);
+        
         //! display graph information
         void printGraphInfo();
         
+        //! add an observer of the events of the graph
+        void addObserver(AOobserver* observer);
+        
+        //! remove an observer of the events of the graph
+        void removeObserver(AOobserver* observer);
+        
         //! suggest the node to solve
         string suggestNext(bool strategy);
         
+        //! suggest the node to solve by Monte Carlo rollouts of the completions (rollout strategy)
+        string suggestByRollouts(int numRollouts, int numThreads = 1, double exploration = 0.3,
+            unsigned int seed = 1);
+        
         //! solve a node, finding it by name
         void solveByName(string nameNode);
         
+        //! solve a node, finding it by identifier
+        void solveById(int idNode);
+        
+        //! solve several nodes at once, finding them by name
+        int solveMany(const vector<string> &namesNodes);
+        
+        //! find the feasible nodes not solved yet
+        vector<AOnode*> getFrontier();
+        
+        //! find the k best paths, in increasing cost order (without generating all paths)
+        vector<Path> findBestPaths(int k);
+        
+        //! determine whether a hyperarc comes first among the equally good ones of a node
+        static bool arcComesFirst(int hIndex, int other);
+        
+        //! change the cost of a node not solved yet, updating the paths including it
+        //! N.B. the costs of the paths are written without locks: no Session or
+        //! StateOverlay on the graph may read them meanwhile (as when solving a node)
+        bool setNodeCost(string nameNode, int cost);
+        
+        //! change the cost of a hyperarc of a node not solved yet, updating the paths including it
+        //! N.B. same as setNodeCost(): no Session or StateOverlay may read the paths meanwhile
+        bool setArcCost(string nameNode, int hIndex, int cost);
+        
+        //! save the solve state (solved nodes, feasibility, path costs) in a binary blob
+        void saveState(vector<char> &state);
+        
+        //! restore a solve state saved by saveState() for the same graph
+        bool restoreState(const vector<char> &state);
+        
+        //! get the statistics of the phases since the last reset
+        GraphStats getStats();
+        
+        //! set the statistics of the phases to zero
+        void resetStats();
+        
         //! destructor
 		~AOgraph()
 		{
@@ -36,10 +36,12 @@ void HyperArc::printArcInfo()
 //! @param[in] cost    generic node cost
 AOnode::AOnode(string name, int cost)
 {
+    nId = -1;
     nName = name;
 	nCost = cost;
     nFeasible = false;
     nSolved = false;
+    nElement = NULL;
     
     //DEBUG:printNodeInfo();
 }
@@ -142,14 +144,14 @@ bool AOnode::setSolved()
     // issue a warning if the node is already solved
     if(nSolved == true)
     {
-        cout<<"[WARNING] The node is already solved." <<endl;
+        ENDOR_MESSAGE("[WARNING] The node is already solved.");
         return false;
     }
     // a node can be solved only if it's feasible
     if (nFeasible == true)
         nSolved = true;
     else
-        cout<<"[ERROR] The node is not feasible. Are you sure it is solved?" <<endl;
+        ENDOR_MESSAGE("[ERROR] The node is not feasible. Are you sure it is solved?");
     
     return nSolved;
 }
\ No newline at end of file
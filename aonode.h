@@ -11,6 +11,7 @@
 #include <iostream>
 #include <vector>
 
+#include "aoobserver.h"
 #include "element.h"
 
 using namespace std;
@@ -44,6 +45,7 @@ class AOnode
 {
     public:
         NodeElement* nElement;      //!< pointer to the application-specific element associated with the node        
+        int nId;                    //!< unique identifier of the node (position in the graph)
         string nName;               //!< name of the node
         int nCost;                  //!< cost of the node
         bool nSolved;               //!< solved: the operation has been performed
@@ -0,0 +1,98 @@
+//===============================================================================//
+// Name			: aoobserver.cpp
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Description	: Observers of the events of an AND-OR graph, log level of the library
+//===============================================================================//
+
+#include "aograph.h"
+
+//! event: the graph has been loaded and set up
+//! @param[in] graph    reference to the graph
+void TextObserver::onLoadFinished(AOgraph &graph)
+{
+    cout<<"Loaded graph description: " <<graph.gName <<endl;
+    for (int i=0; i < (int)graph.paths.size(); i++)
+        graph.paths[i].printPathInfo();
+}
+
+//! event: a node has been solved
+//! @param[in] graph    reference to the graph
+//! @param[in] node     reference to the solved node
+void TextObserver::onNodeSolved(AOgraph &graph, AOnode &node)
+{
+    graph.printGraphInfo();
+}
+
+//! event: several nodes have been solved at once
+//! @param[in] graph    reference to the graph
+//! @param[in] nodes    solved nodes, in the order they have been solved
+void TextObserver::onBatchSolved(AOgraph &graph, const vector<AOnode*> &nodes)
+{
+    // the graph information is displayed once for the whole batch
+    graph.printGraphInfo();
+}
+
+//! event: the cost of a path has been updated
+//! @param[in] graph    reference to the graph
+//! @param[in] index    index of the path
+//! @param[in] cost     updated cost of the path
+void TextObserver::onPathUpdated(AOgraph &graph, int index, int cost)
+{
+    cout<<"Path: " <<index <<endl;
+    cout<<"Updated path cost: " <<cost <<endl;
+}
+
+//! event: all paths have been updated after solving a node
+//! @param[in] graph    reference to the graph
+void TextObserver::onUpdateFinished(AOgraph &graph)
+{
+    cout<<endl <<"Updated paths: " <<endl;
+    for(int i=0; i< (int)graph.pUpdate.size(); i++)
+        cout<<"Path index: " <<graph.pIndices[i] <<" - Benefit: " <<graph.pUpdate[i] <<endl;
+}
+
+//! event: a node has been suggested
+//! @param[in] graph    reference to the graph
+//! @param[in] path     path along which the node has been suggested
+//! @param[in] node     suggested node (NULL = no suggestion possible)
+//! @param[in] strategy "0" = short-sighted, "1" = long-sighted
+void TextObserver::onSuggestionMade(AOgraph &graph, Path &path, AOnode* node, bool strategy)
+{
+    // the path is displayed only when it is the optimal one
+    if (graph.gEngine == ENGINE_SOLUTION_GRAPH)
+    {
+        cout<<"The optimal path is the optimal solution graph" <<endl;
+        path.printPathInfo();
+    }
+    else if (strategy == true)
+    {
+        cout<<"The optimal path is: " <<path.pIndex <<endl;
+        path.printPathInfo();
+    }
+    
+    if (node == NULL)
+        return;
+    cout<<"ENDOR suggestion: " <<endl;
+    if (graph.gEngine == ENGINE_PATHS)
+        cout<<"Suggested path = " <<path.pIndex <<endl;
+    cout<<"Suggested node = " <<node->nName <<endl;
+}
+
+//! event: a node has been suggested by rollouts
+//! @param[in] graph        reference to the graph
+//! @param[in] candidates   feasible nodes not solved yet
+//! @param[in] scores       average completion cost of each candidate
+//! @param[in] node         suggested node (NULL = no suggestion possible)
+void TextObserver::onRolloutsFinished(AOgraph &graph, const vector<AOnode*> &candidates,
+    const vector<double> &scores, AOnode* node)
+{
+    cout<<"Average completion cost of the feasible nodes: " <<endl;
+    for (int i=0; i< (int)candidates.size(); i++)
+        cout<<candidates[i]->nName <<" - Cost: " <<scores[i] <<endl;
+    
+    if (node == NULL)
+        return;
+    cout<<"ENDOR suggestion: " <<endl;
+    cout<<"Suggested node = " <<node->nName <<endl;
+}
@@ -0,0 +1,109 @@
+//===============================================================================//
+// Name			: aoobserver.h
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Description	: Observers of the events of an AND-OR graph, log level of the library
+//===============================================================================//
+
+#ifndef AOOBSERVER_H
+#define AOOBSERVER_H
+
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+//! log levels of the library (fix one at compile time with -DENDOR_LOG_LEVEL=[0/1/2])
+#define ENDOR_LOG_NONE      0   //!< no output
+#define ENDOR_LOG_ERRORS    1   //!< errors, warnings and reports only
+#define ENDOR_LOG_EVENTS    2   //!< errors, warnings, reports and events (text observer)
+
+#ifndef ENDOR_LOG_LEVEL
+#define ENDOR_LOG_LEVEL ENDOR_LOG_EVENTS
+#endif
+
+//! display an error, warning or report message (compiled out below ENDOR_LOG_ERRORS)
+#if ENDOR_LOG_LEVEL >= ENDOR_LOG_ERRORS
+#define ENDOR_MESSAGE(text) cout<<text <<endl
+#else
+#define ENDOR_MESSAGE(text) do {} while (0)
+#endif
+
+// empty declarations (required by AOobserver)
+class AOgraph;
+class AOnode;
+class Path;
+
+//! class "AOobserver" for the observers of the events of an AND-OR graph
+//! N.B. the default implementation of each event does nothing
+class AOobserver
+{
+    public:
+        //! event: the graph has been loaded and set up
+        virtual void onLoadFinished(AOgraph &graph) {}
+        
+        //! event: a node has been solved
+        virtual void onNodeSolved(AOgraph &graph, AOnode &node) {}
+        
+        //! event: several nodes have been solved at once (see AOgraph::solveMany())
+        //! N.B. by default, each node is notified as if solved alone
+        virtual void onBatchSolved(AOgraph &graph, const vector<AOnode*> &nodes)
+        {
+            for (int i=0; i< (int)nodes.size(); i++)
+                onNodeSolved(graph, *nodes[i]);
+        }
+        
+        //! event: the cost of a path has been updated
+        virtual void onPathUpdated(AOgraph &graph, int index, int cost) {}
+        
+        //! event: all paths have been updated after solving a node
+        virtual void onUpdateFinished(AOgraph &graph) {}
+        
+        //! event: a node has been suggested
+        virtual void onSuggestionMade(AOgraph &graph, Path &path, AOnode* node, bool strategy) {}
+        
+        //! event: a node has been suggested by rollouts (see AOgraph::suggestByRollouts())
+        virtual void onRolloutsFinished(AOgraph &graph, const vector<AOnode*> &candidates,
+            const vector<double> &scores, AOnode* node) {}
+        
+        //! destructor
+        virtual ~AOobserver()
+        {
+            //DEBUG:cout<<endl <<"Destroying AOobserver object" <<endl;
+        }
+};
+
+//! class "TextObserver" displaying the events of an AND-OR graph on the console
+class TextObserver: public AOobserver
+{
+    public:
+        //! event: the graph has been loaded and set up
+        void onLoadFinished(AOgraph &graph);
+        
+        //! event: a node has been solved
+        void onNodeSolved(AOgraph &graph, AOnode &node);
+        
+        //! event: several nodes have been solved at once
+        void onBatchSolved(AOgraph &graph, const vector<AOnode*> &nodes);
+        
+        //! event: the cost of a path has been updated
+        void onPathUpdated(AOgraph &graph, int index, int cost);
+        
+        //! event: all paths have been updated after solving a node
+        void onUpdateFinished(AOgraph &graph);
+        
+        //! event: a node has been suggested
+        void onSuggestionMade(AOgraph &graph, Path &path, AOnode* node, bool strategy);
+        
+        //! event: a node has been suggested by rollouts
+        void onRolloutsFinished(AOgraph &graph, const vector<AOnode*> &candidates,
+            const vector<double> &scores, AOnode* node);
+        
+        //! destructor
+        ~TextObserver()
+        {
+            //DEBUG:cout<<endl <<"Destroying TextObserver object" <<endl;
+        }
+};
+
+#endif
@@ -0,0 +1,279 @@
+//===============================================================================//
+// Name			: bench.cpp
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Version		: 1.0
+// Description	: Benchmark of the AND-OR graph library on synthetic graphs
+//===============================================================================//
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "aograph.h"
+#include "graphgenerator.h"
+
+using namespace std;
+
+//! class "BenchGraph" for a graph whose path generation can be timed alone
+class BenchGraph: public AOgraph
+{
+    public:
+        //! constructor
+        BenchGraph(string name, PathEngine engine): AOgraph(name, engine) {}
+        
+        //! generate the paths again (same paths as the loading)
+        void regeneratePaths()
+        {
+            generatePaths();
+        }
+        
+        //! index the paths again (required by the path updates)
+        void rebuildIndex()
+        {
+            paths.buildIndex(graph.size(), numArcs);
+        }
+};
+
+//! class "BenchResult" for the timings on one graph with one engine
+class BenchResult
+{
+    public:
+        string graphName;       //!< name of the generated graph
+        GraphSettings settings; //!< shape of the generated graph
+        int numNodes;           //!< number of nodes
+        int numArcs;            //!< number of hyperarcs
+        double numPaths;        //!< number of paths navigating the graph
+        string engine;          //!< engine used to identify the optimal path
+        double loadMs;          //!< time of loadFromFile() (ms)
+        double generateMs;      //!< time of generatePaths() (ms, < 0 = not applicable)
+        int numSolved;          //!< number of nodes solved
+        double solveUs;         //!< average time of solveByName() (us)
+        double longUs;          //!< average time of suggestNext() with the long-sighted strategy (us)
+        double shortUs;         //!< average time of suggestNext() with the short-sighted strategy (us)
+};
+
+// elapsed time since a starting point, in microseconds
+double elapsedUs(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+}
+
+// time the loading, path generation, solving and suggestions on a graph
+BenchResult runBenchmark(const string &fileName, PathEngine engine, int maxSteps)
+{
+    BenchResult result;
+    result.engine = (engine == ENGINE_PATHS) ? "paths" : "solution_graph";
+    result.generateMs = -1.0;
+    result.numSolved = 0;
+    result.solveUs = 0.0;
+    result.longUs = 0.0;
+    result.shortUs = 0.0;
+    
+    BenchGraph graph("BENCH", engine);
+    graph.removeObserver(&graph.textObserver);
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    graph.loadFromFile(fileName);
+    result.loadMs = elapsedUs(start)/1000.0;
+    if (engine == ENGINE_PATHS)
+    {
+        start = chrono::steady_clock::now();
+        graph.regeneratePaths();
+        result.generateMs = elapsedUs(start)/1000.0;
+        graph.rebuildIndex();
+    }
+    
+    // solve the suggested nodes (long-sighted strategy), timing each call
+    for (int i=0; (i< maxSteps) && (graph.head != NULL) && (graph.head->nSolved == false); i++)
+    {
+        start = chrono::steady_clock::now();
+        string suggestion = graph.suggestNext(true);
+        result.longUs = result.longUs + elapsedUs(start);
+        start = chrono::steady_clock::now();
+        graph.suggestNext(false);
+        result.shortUs = result.shortUs + elapsedUs(start);
+        if ((suggestion.empty() == true) || (suggestion == "end"))
+            break;
+        
+        start = chrono::steady_clock::now();
+        graph.solveByName(suggestion);
+        result.solveUs = result.solveUs + elapsedUs(start);
+        result.numSolved++;
+    }
+    if (result.numSolved > 0)
+    {
+        result.solveUs = result.solveUs/result.numSolved;
+        result.longUs = result.longUs/result.numSolved;
+        result.shortUs = result.shortUs/result.numSolved;
+    }
+    
+    return result;
+}
+
+// write the results as CSV (one line per graph and engine)
+void writeCsv(ostream &output, const vector<BenchResult> &results)
+{
+    output<<"graph,depth,or_branching,and_fanout,sharing,nodes,hyperarcs,paths,engine,"
+        <<"load_ms,generate_ms,solved,solve_us,suggest_long_us,suggest_short_us" <<endl;
+    for (int i=0; i< (int)results.size(); i++)
+    {
+        const BenchResult &r = results[i];
+        output<<r.graphName <<"," <<r.settings.depth <<"," <<r.settings.orBranching <<","
+            <<r.settings.andFanout <<"," <<r.settings.sharing <<"," <<r.numNodes <<"," <<r.numArcs <<","
+            <<r.numPaths <<"," <<r.engine <<"," <<r.loadMs <<",";
+        if (r.generateMs >= 0)
+            output<<r.generateMs;
+        output<<"," <<r.numSolved <<"," <<r.solveUs <<"," <<r.longUs <<"," <<r.shortUs <<endl;
+    }
+}
+
+// write the results as JSON (array of objects, one per graph and engine)
+void writeJson(ostream &output, const vector<BenchResult> &results)
+{
+    output<<"[" <<endl;
+    for (int i=0; i< (int)results.size(); i++)
+    {
+        const BenchResult &r = results[i];
+        output<<"  {\"graph\": \"" <<r.graphName <<"\", \"depth\": " <<r.settings.depth
+            <<", \"or_branching\": " <<r.settings.orBranching <<", \"and_fanout\": " <<r.settings.andFanout
+            <<", \"sharing\": " <<r.settings.sharing <<", \"nodes\": " <<r.numNodes
+            <<", \"hyperarcs\": " <<r.numArcs <<", \"paths\": " <<r.numPaths
+            <<", \"engine\": \"" <<r.engine <<"\", \"load_ms\": " <<r.loadMs <<", \"generate_ms\": ";
+        if (r.generateMs >= 0)
+            output<<r.generateMs;
+        else
+            output<<"null";
+        output<<", \"solved\": " <<r.numSolved <<", \"solve_us\": " <<r.solveUs
+            <<", \"suggest_long_us\": " <<r.longUs <<", \"suggest_short_us\": " <<r.shortUs <<"}";
+        output<<((i < (int)results.size()-1) ? "," : "") <<endl;
+    }
+    output<<"]" <<endl;
+}
+
+// display the usage of the benchmark
+void displayHelp()
+{
+    cout<<"Usage: endor_bench [options]" <<endl;
+    cout<<"  -f <format>    results format: csv or json (default csv)" <<endl;
+    cout<<"  -o <file>      results file (default: standard output)" <<endl;
+    cout<<"  -g <folder>    folder of the generated graph descriptions (default .)" <<endl;
+    cout<<"  -p <paths>     maximum number of paths to run the paths engine (default 1000000)" <<endl;
+    cout<<"  -n <steps>     maximum number of nodes to solve in each graph (default 50)" <<endl;
+    cout<<"  -c <distribution>  costs: constant, uniform or skewed (default uniform)" <<endl;
+    cout<<"  -r <seed>      seed of the random generator (default 1)" <<endl;
+}
+
+int main(int argc, char **argv)
+{
+    string format = "csv";
+    string outputName;
+    string folder = ".";
+    double maxPaths = 1000000;
+    int maxSteps = 50;
+    GraphSettings settings;
+    
+    for (int i=1; i< argc; i++)
+    {
+        if ((strlen(argv[i]) != 2) || (argv[i][0] != '-') || (i == argc-1))
+        {
+            displayHelp();
+            return 1;
+        }
+        char option = argv[i][1];
+        char* value = argv[++i];
+        switch(option)
+        {
+            case 'f':
+                format = value;
+                break;
+            case 'o':
+                outputName = value;
+                break;
+            case 'g':
+                folder = value;
+                break;
+            case 'p':
+                maxPaths = atof(value);
+                break;
+            case 'n':
+                maxSteps = atoi(value);
+                break;
+            case 'c':
+                if (strcmp(value, "constant") == 0)
+                    settings.costs = COST_CONSTANT;
+                else if (strcmp(value, "skewed") == 0)
+                    settings.costs = COST_SKEWED;
+                else
+                    settings.costs = COST_UNIFORM;
+                break;
+            case 'r':
+                settings.seed = strtoul(value, NULL, 10);
+                break;
+            default:
+                displayHelp();
+                return 1;
+        }
+    }
+    
+    // the output of the library is discarded while timing
+    streambuf* console = cout.rdbuf();
+    cout.rdbuf(NULL);
+    
+    // sizes: depth x OR-branching x AND-fanout x node sharing
+    const int depths[] = {2, 3, 4, 5};
+    const int branchings[] = {1, 2, 3};
+    const int fanouts[] = {2, 3};
+    const double sharings[] = {0.0, 0.5};
+    vector<BenchResult> results;
+    for (int d=0; d< 4; d++)
+    for (int o=0; o< 3; o++)
+    for (int a=0; a< 2; a++)
+    for (int s=0; s< 2; s++)
+    {
+        settings.depth = depths[d];
+        settings.orBranching = branchings[o];
+        settings.andFanout = fanouts[a];
+        settings.sharing = sharings[s];
+        GraphGenerator generator(settings);
+        generator.generate();
+        string fileName = folder + "/" + settings.graphName() + ".txt";
+        if (generator.writeDescription(fileName) == false)
+            continue;
+        
+        // the paths engine is skipped when the paths would not fit in memory
+        for (int e=0; e< 2; e++)
+        {
+            PathEngine engine = (e == 0) ? ENGINE_PATHS : ENGINE_SOLUTION_GRAPH;
+            if ((engine == ENGINE_PATHS) && (generator.countPaths() > maxPaths))
+                continue;
+            
+            BenchResult result = runBenchmark(fileName, engine, maxSteps);
+            result.graphName = settings.graphName();
+            result.settings = settings;
+            result.numNodes = generator.numNodes();
+            result.numArcs = generator.numArcs();
+            result.numPaths = generator.countPaths();
+            results.push_back(result);
+        }
+    }
+    cout.rdbuf(console);
+    
+    ofstream outputFile;
+    if (outputName.empty() == false)
+    {
+        outputFile.open(outputName.c_str());
+        if (!outputFile)
+        {
+            cout<<"Unable to write the results to " <<outputName <<endl;
+            return 1;
+        }
+    }
+    ostream &output = (outputName.empty() == true) ? cout : outputFile;
+    if (format == "json")
+        writeJson(output, results);
+    else
+        writeCsv(output, results);
+    
+    return 0;
+}
@@ -0,0 +1,221 @@
+//===============================================================================//
+// Name			: compiledgraph.cpp
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Description	: Read-only compiled form of an AND-OR graph (compressed sparse rows)
+//===============================================================================//
+
+#include <algorithm>
+
+#include "compiledgraph.h"
+#include "graphimage.h"
+
+//! constructor of class CompiledGraph
+CompiledGraph::CompiledGraph()
+{
+    numNodes = 0;
+}
+
+//! compile the nodes of a graph
+//! @param[in] graph    nodes of the graph (the identifier of a node is its position)
+void CompiledGraph::build(NodeArena &graph)
+{
+    clear();
+    numNodes = (int)graph.size();
+    node.resize(numNodes);
+    nodeCost.resize(numNodes);
+    arcOffset.resize(numNodes+1);
+    parentOffset.assign(numNodes+1, 0);
+    
+    // hyperarcs and child nodes, in the order of the nodes
+    for (int i=0; i< numNodes; i++)
+    {
+        node[i] = &graph[i];
+        nodeCost[i] = graph[i].nCost;
+        arcOffset[i] = (int)arcCost.size();
+        for (int j=0; j< (int)graph[i].arcs.size(); j++)
+        {
+            const HyperArc &arc = graph[i].arcs[j];
+            arcIndex.push_back(arc.hIndex);
+            arcCost.push_back(arc.hCost);
+            childOffset.push_back((int)childNode.size());
+            for (int k=0; k< (int)arc.children.size(); k++)
+                childNode.push_back(arc.children[k]->nId);
+        }
+    }
+    arcOffset[numNodes] = (int)arcCost.size();
+    childOffset.push_back((int)childNode.size());
+    
+    // parents: count them, then fill them in the order of the (parent, hyperarc) pairs
+    // N.B. a child listed twice in a hyperarc has the parent once
+    vector<int> lastArc(numNodes, -1);
+    for (int a=0; a< numArcs(); a++)
+    {
+        for (int c = childOffset[a]; c < childOffset[a+1]; c++)
+        {
+            if (lastArc[childNode[c]] == a)
+                continue;
+            lastArc[childNode[c]] = a;
+            parentOffset[childNode[c]+1]++;
+        }
+    }
+    for (int i=0; i< numNodes; i++)
+        parentOffset[i+1] = parentOffset[i+1] + parentOffset[i];
+    
+    parentNode.resize(parentOffset[numNodes]);
+    parentArc.resize(parentOffset[numNodes]);
+    vector<int> nextParent(parentOffset.begin(), parentOffset.end()-1);
+    lastArc.assign(numNodes, -1);
+    for (int i=0; i< numNodes; i++)
+    {
+        for (int a = arcOffset[i]; a < arcOffset[i+1]; a++)
+        {
+            for (int c = childOffset[a]; c < childOffset[a+1]; c++)
+            {
+                int child = childNode[c];
+                if (lastArc[child] == a)
+                    continue;
+                lastArc[child] = a;
+                parentNode[nextParent[child]] = i;
+                parentArc[nextParent[child]] = a;
+                nextParent[child]++;
+            }
+        }
+    }
+}
+
+//! copy the flat arrays of a binary image
+//! @param[in] image    mapped binary image
+//! @param[in] graph    nodes of the graph, created from the image
+void CompiledGraph::load(const GraphImage &image, NodeArena &graph)
+{
+    clear();
+    const ImageHeader &header = *image.header;
+    numNodes = header.iNumNodes;
+    node.resize(numNodes);
+    for (int i=0; i< numNodes; i++)
+        node[i] = &graph[i];
+    
+    nodeCost.assign(image.nodeCost, image.nodeCost + numNodes);
+    arcOffset.assign(image.arcOffset, image.arcOffset + numNodes+1);
+    arcIndex.assign(image.arcIndex, image.arcIndex + header.iNumArcs);
+    arcCost.assign(image.arcCost, image.arcCost + header.iNumArcs);
+    childOffset.assign(image.childOffset, image.childOffset + header.iNumArcs+1);
+    childNode.assign(image.childNode, image.childNode + header.iNumChildren);
+    parentOffset.assign(image.parentOffset, image.parentOffset + numNodes+1);
+    parentNode.assign(image.parentNode, image.parentNode + header.iNumParents);
+    parentArc.assign(image.parentArc, image.parentArc + header.iNumParents);
+}
+
+//! remove all nodes
+void CompiledGraph::clear()
+{
+    numNodes = 0;
+    node.clear();
+    nodeCost.clear();
+    arcOffset.clear();
+    arcIndex.clear();
+    arcCost.clear();
+    childOffset.clear();
+    childNode.clear();
+    parentOffset.clear();
+    parentNode.clear();
+    parentArc.clear();
+}
+
+//! find the hyperarc connecting a parent to a child node
+//! @param[in] parent   identifier of the parent node
+//! @param[in] child    identifier of the child node
+//! @return             hyperarc connecting the parent to the child (-1 = none)
+int CompiledGraph::findLink(int parent, int child) const
+{
+    // the parents of a node are sorted: the link is the last entry of the parent
+    vector<int>::const_iterator first = parentNode.begin() + parentOffset[child];
+    vector<int>::const_iterator last = parentNode.begin() + parentOffset[child+1];
+    vector<int>::const_iterator found = std::upper_bound(first, last, parent);
+    if ((found == first) || (*(found-1) != parent))
+        return -1;
+    
+    return parentArc[found-1 - parentNode.begin()];
+}
+
+//! count the paths from a node, as generated by AOgraph::generatePaths() (without generating them)
+//! N.B. a path chooses one hyperarc for each occurrence of a node, hence over
+//! the graph (a DAG) the paths of a non-terminal node are the sum over its
+//! hyperarcs of the product of the paths of its child nodes (each occurrence
+//! counted): the child nodes are counted first, with an explicit stack
+//! @param[in] head         identifier of the node the paths start from
+//! @param[out] numPaths    number of complete paths (exact up to 2^53)
+//! @param[out] totalLength overall number of nodes in all paths
+//! @return                 false if a cycle is reachable from the node (infinite paths)
+bool CompiledGraph::countPaths(int head, double &numPaths, double &totalLength) const
+{
+    numPaths = 0.0;
+    totalLength = 0.0;
+    if ((head < 0) || (head >= numNodes))
+        return true;
+    
+    // state of each node: 0 = not visited, 1 = child nodes being counted, 2 = counted
+    vector<double> count(numNodes, 0.0);
+    vector<double> length(numNodes, 0.0);
+    vector<char> state(numNodes, 0);
+    vector<int> stack(1, head);
+    while (stack.empty() == false)
+    {
+        int current = stack.back();
+        if (state[current] == 0)
+        {
+            // 1. visit the node: its child nodes are counted first
+            // N.B. a child being counted is an ancestor of the node: there is a cycle
+            state[current] = 1;
+            for (int c = childOffset[arcOffset[current]]; c < childOffset[arcOffset[current+1]]; c++)
+            {
+                int child = childNode[c];
+                if (state[child] == 1)
+                    return false;
+                if (state[child] == 0)
+                    stack.push_back(child);
+            }
+            continue;
+        }
+        stack.pop_back();
+        if (state[current] == 2)
+            continue;
+        
+        // 2. count the paths of the node, and their overall length:
+        //    the length of a path is 1 + the lengths of the paths of the child nodes
+        state[current] = 2;
+        if (arcOffset[current] == arcOffset[current+1])
+        {
+            count[current] = 1.0;
+            length[current] = 1.0;
+            continue;
+        }
+        for (int a = arcOffset[current]; a < arcOffset[current+1]; a++)
+        {
+            double arcCount = 1.0;
+            double arcLength = 0.0;
+            for (int c = childOffset[a]; c < childOffset[a+1]; c++)
+            {
+                int child = childNode[c];
+                arcLength = arcLength*count[child] + arcCount*length[child];
+                arcCount = arcCount*count[child];
+            }
+            count[current] = count[current] + arcCount;
+            length[current] = length[current] + arcCount + arcLength;
+        }
+    }
+    
+    numPaths = count[head];
+    totalLength = length[head];
+    return true;
+}
+
+//! approximate memory used by the compiled graph (in bytes)
+//! @return bytes used by the flat arrays
+size_t CompiledGraph::memoryUsage() const
+{
+    return node.capacity()*sizeof(AOnode*) + (nodeCost.capacity() + arcOffset.capacity()
+        + arcIndex.capacity() + arcCost.capacity() + childOffset.capacity() + childNode.capacity()
+        + parentOffset.capacity() + parentNode.capacity() + parentArc.capacity())*sizeof(int);
+}
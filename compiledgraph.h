@@ -0,0 +1,80 @@
+//===============================================================================//
+// Name			: compiledgraph.h
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Description	: Read-only compiled form of an AND-OR graph (compressed sparse rows)
+//===============================================================================//
+
+#ifndef COMPILEDGRAPH_H
+#define COMPILEDGRAPH_H
+
+#include "nodearena.h"
+
+using namespace std;
+
+// empty declaration (required by CompiledGraph)
+class GraphImage;
+
+//! class "CompiledGraph" for the read-only compiled form of an AND-OR graph
+//! N.B. the hyperarcs, child nodes and parents are stored in flat arrays:
+//! 1. the hyperarcs of node i are arcOffset[i] ... arcOffset[i+1]-1
+//! 2. the child nodes of hyperarc a are childOffset[a] ... childOffset[a+1]-1
+//! 3. the parents of node i are parentOffset[i] ... parentOffset[i+1]-1
+//! the hyperarc a of node i is the hyperarc (a - arcOffset[i]) in AOnode::arcs
+class CompiledGraph
+{
+    public:
+        int numNodes;               //!< number of nodes in the graph
+        vector<AOnode*> node;       //!< node with each identifier
+        vector<int> nodeCost;       //!< cost of each node
+        vector<int> arcOffset;      //!< first hyperarc of each node (numNodes+1 entries)
+        vector<int> arcIndex;       //!< index (HyperArc::hIndex) of each hyperarc
+        vector<int> arcCost;        //!< cost of each hyperarc
+        vector<int> childOffset;    //!< first child node of each hyperarc (one entry more than the hyperarcs)
+        vector<int> childNode;      //!< identifier of each child node
+        vector<int> parentOffset;   //!< first parent of each node (numNodes+1 entries)
+        vector<int> parentNode;     //!< identifier of each parent, once per hyperarc including the node
+        vector<int> parentArc;      //!< hyperarc of the parent including the node
+        
+        //! constructor
+        CompiledGraph();
+        
+        //! compile the nodes of a graph
+        void build(NodeArena &graph);
+        
+        //! copy the flat arrays of a binary image
+        void load(const GraphImage &image, NodeArena &graph);
+        
+        //! remove all nodes
+        void clear();
+        
+        //! number of hyperarcs in the graph
+        int numArcs() const
+        {
+            return (int)arcCost.size();
+        }
+        
+        //! determine whether a parent entry of a node is the link of its parent to the node
+        //! N.B. if several hyperarcs connect a parent to a node, the link is the last one
+        bool isLink(int child, int entry) const
+        {
+            return (entry+1 == parentOffset[child+1]) || (parentNode[entry+1] != parentNode[entry]);
+        }
+        
+        //! find the hyperarc connecting a parent to a child node
+        int findLink(int parent, int child) const;
+        
+        //! count the paths from a node, as generated by AOgraph::generatePaths() (without generating them)
+        bool countPaths(int head, double &numPaths, double &totalLength) const;
+        
+        //! approximate memory used by the compiled graph (in bytes)
+        size_t memoryUsage() const;
+        
+        //! destructor
+		~CompiledGraph()
+		{
+			//DEBUG:cout<<endl <<"Destroying CompiledGraph object" <<endl;
+		}
+};
+
+#endif
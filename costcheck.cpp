@@ -0,0 +1,229 @@
+//===============================================================================//
+// Name			: costcheck.cpp
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Version		: 1.0
+// Description	: Check of the costs changed at runtime against a graph loaded with them
+//===============================================================================//
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+
+#include "aograph.h"
+#include "graphgenerator.h"
+
+using namespace std;
+
+// load a graph without displaying its events
+void loadQuiet(AOgraph &graph, const string &fileName)
+{
+    graph.removeObserver(&graph.textObserver);
+    graph.loadFromFile(fileName);
+}
+
+// write the description of a graph with its current costs
+// N.B. the hyperarcs are written in index order, as in the loaded description
+bool writeCosts(const AOgraph &graph, const string &fileName)
+{
+    ofstream graphFile(fileName.c_str());
+    graphFile<<graph.gName <<" " <<graph.graph.size() <<" " <<graph.head->nName <<endl;
+    for (int i=0; i< (int)graph.graph.size(); i++)
+        graphFile<<graph.graph[i].nName <<" " <<graph.graph[i].nCost <<endl;
+    
+    // index of each hyperarc, then its node and position in the node
+    vector< pair<int, pair<int, int> > > arcs;
+    for (int i=0; i< (int)graph.graph.size(); i++)
+        for (int j=0; j< (int)graph.graph[i].arcs.size(); j++)
+            arcs.push_back(make_pair(graph.graph[i].arcs[j].hIndex, make_pair(i, j)));
+    sort(arcs.begin(), arcs.end());
+    for (int i=0; i< (int)arcs.size(); i++)
+    {
+        const AOnode &node = graph.graph[arcs[i].second.first];
+        const HyperArc &arc = node.arcs[arcs[i].second.second];
+        graphFile<<arc.children.size() <<" " <<node.nName <<" " <<arc.hCost <<endl;
+        for (int j=0; j< (int)arc.children.size(); j++)
+            graphFile<<arc.children[j]->nName <<endl;
+    }
+    
+    return (bool)graphFile;
+}
+
+// determine whether a child node of a hyperarc is solved
+bool hasSolvedChild(const HyperArc &arc)
+{
+    for (int i=0; i< (int)arc.children.size(); i++)
+        if (arc.children[i]->nSolved == true)
+            return true;
+    
+    return false;
+}
+
+// change the cost of a random node not solved yet, or of a random hyperarc of it
+// N.B. the costs subtracted when a child node of a hyperarc was solved are
+// kept when the cost of the hyperarc changes (see AOgraph::setArcCost()): a
+// graph loaded with the new costs would subtract others, hence only the
+// hyperarcs without solved child nodes change
+void changeCost(AOgraph &graph, mt19937 &generator)
+{
+    AOnode &node = graph.graph[generator() % graph.graph.size()];
+    int cost = generator() % 10;
+    if (node.nSolved == true)
+        return;
+    if ((node.arcs.empty() == true) || (generator() % 2 == 0))
+        graph.setNodeCost(node.nName, cost);
+    else
+    {
+        int hIndex = generator() % node.arcs.size();
+        if (hasSolvedChild(node.arcs[hIndex]) == false)
+            graph.setArcCost(node.nName, hIndex, cost);
+    }
+}
+
+// check that the cost of a hyperarc with solved child nodes is added to the
+// paths once per occurrence, keeping the costs subtracted by the child nodes
+int checkKeptCosts(AOgraph &graph, const string &what)
+{
+    for (int i=0; i< (int)graph.graph.size(); i++)
+    {
+        AOnode &node = graph.graph[i];
+        for (int j=0; (j < (int)node.arcs.size()) && (node.nSolved == false); j++)
+        {
+            if (hasSolvedChild(node.arcs[j]) == false)
+                continue;
+            
+            vector<int> expected = graph.paths.costs;
+            const vector<PathOccurrence> &withArc = graph.paths.arcPaths[graph.compiled.arcIndex[graph.compiled.arcOffset[i] + j]];
+            for (int k=0; k< (int)withArc.size(); k++)
+                expected[withArc[k].oPath] += 3*withArc[k].oCount;
+            graph.setArcCost(node.nName, j, node.arcs[j].hCost + 3);
+            if (graph.paths.costs != expected)
+            {
+                cout<<"[ERROR] " <<what <<": the costs subtracted by the solved child nodes of a hyperarc "
+                    <<"of node " <<node.nName <<" are not kept." <<endl;
+                return 1;
+            }
+            return 0;
+        }
+    }
+    
+    return 0;
+}
+
+// check that a graph whose costs changed answers as the graph loaded with the new costs
+int checkSame(AOgraph &changed, AOgraph &loaded, const string &what)
+{
+    int failed = 0;
+    if ((changed.gEngine == ENGINE_PATHS) && (changed.paths.costs != loaded.paths.costs))
+    {
+        cout<<"[ERROR] " <<what <<": the costs of the paths differ." <<endl;
+        failed++;
+    }
+    if (changed.head->nSolved == true)
+        return failed;
+    
+    if (changed.suggestNext(true) != loaded.suggestNext(true))
+    {
+        cout<<"[ERROR] " <<what <<": the long-sighted suggestions differ." <<endl;
+        failed++;
+    }
+    // N.B. the optimal path is the first path with minimum cost (min_element keeps the first)
+    int first = min_element(loaded.paths.costs.begin(), loaded.paths.costs.end()) - loaded.paths.costs.begin();
+    if ((changed.gEngine == ENGINE_PATHS)
+        && ((changed.paths.findCheapest() != first) || (loaded.paths.findCheapest() != first)))
+    {
+        cout<<"[ERROR] " <<what <<": the optimal paths differ." <<endl;
+        failed++;
+    }
+    if ((changed.gEngine == ENGINE_SOLUTION_GRAPH)
+        && ((changed.optimalPath.pathArcs != loaded.optimalPath.pathArcs)
+        || (changed.optimalPath.pCost != loaded.optimalPath.pCost)))
+    {
+        cout<<"[ERROR] " <<what <<": the optimal paths differ." <<endl;
+        failed++;
+    }
+    if ((changed.gEngine == ENGINE_PATHS) && (changed.suggestNext(false) != loaded.suggestNext(false)))
+    {
+        cout<<"[ERROR] " <<what <<": the short-sighted suggestions differ." <<endl;
+        failed++;
+    }
+    
+    return failed;
+}
+
+// check the costs changed at runtime on one graph, at load and while solving it
+int checkGraph(const string &fileName, PathEngine engine, unsigned int seed)
+{
+    string costsName = "costcheck_costs.txt";
+    AOgraph changed("CHANGED", engine);
+    loadQuiet(changed, fileName);
+    mt19937 generator(seed);
+    
+    // costs changed before solving any node
+    for (int i=0; i< 5; i++)
+        changeCost(changed, generator);
+    writeCosts(changed, costsName);
+    AOgraph loaded("LOADED", engine);
+    loadQuiet(loaded, costsName);
+    int failed = checkSame(changed, loaded, fileName + " at load");
+    
+    // costs changed between the solved nodes: the graph loaded with the new
+    // costs solves the same nodes
+    vector<string> solved;
+    for (int step = 1; changed.head->nSolved == false; step++)
+    {
+        vector<AOnode*> frontier = changed.getFrontier();
+        solved.push_back(frontier[generator() % frontier.size()]->nName);
+        changed.solveByName(solved.back());
+        changeCost(changed, generator);
+        string what = fileName + " after " + to_string(step) + " solved nodes";
+        
+        writeCosts(changed, costsName);
+        AOgraph reloaded("RELOADED", engine);
+        loadQuiet(reloaded, costsName);
+        for (int i=0; i< (int)solved.size(); i++)
+            reloaded.solveByName(solved[i]);
+        failed = failed + checkSame(changed, reloaded, what);
+        if (engine == ENGINE_PATHS)
+            failed = failed + checkKeptCosts(reloaded, what);
+    }
+    remove(costsName.c_str());
+    
+    return failed;
+}
+
+int main(int argc, char **argv)
+{
+    int numGraphs = (argc > 1) ? atoi(argv[1]) : 12;
+    int failed = 0;
+    int numChecked = 0;
+    for (int i=0; i< numGraphs; i++)
+    {
+        // trees and graphs with shared nodes, and a graph with one path
+        GraphSettings settings;
+        settings.depth = 2 + (i / 2) % 2;
+        settings.orBranching = (i == 0) ? 1 : 2 + (i / 4) % 2;
+        settings.andFanout = 2;
+        settings.sharing = (i % 2 == 0) ? 0.0 : 0.4;
+        settings.seed = i+1;
+        GraphGenerator generator(settings);
+        generator.generate();
+        if (generator.countPaths() > 1000)
+            continue;
+        string fileName = "costcheck_" + settings.graphName() + ".txt";
+        if (generator.writeDescription(fileName) == false)
+            return 1;
+        
+        failed = failed + checkGraph(fileName, ENGINE_PATHS, settings.seed);
+        failed = failed + checkGraph(fileName, ENGINE_SOLUTION_GRAPH, settings.seed);
+        numChecked++;
+        remove(fileName.c_str());
+    }
+    
+    cout<<"[REPORT] " <<numChecked <<" graphs: " <<failed <<" failed checks of the changed costs." <<endl;
+    
+    return (failed == 0) ? 0 : 1;
+}
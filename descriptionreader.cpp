@@ -0,0 +1,186 @@
+//===============================================================================//
+// Name			: descriptionreader.cpp
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Description	: Buffered tokenizer of the text description of an AND-OR graph
+//===============================================================================//
+
+#include <climits>
+
+#include "descriptionreader.h"
+
+//! size of the blocks read from the file
+#define BLOCK_BYTES 65536
+
+//! determine whether a character separates two tokens
+//! @param[in] c    character to check
+//! @return         true for blanks, tabs and line breaks
+static inline bool isSeparator(char c)
+{
+    return (c == ' ') || ((c >= '\t') && (c <= '\r'));
+}
+
+//! constructor of class DescriptionReader
+DescriptionReader::DescriptionReader()
+{
+    position = 0;
+    filled = 0;
+    endOfFile = true;
+    line = 1;
+    lineStart = 0;
+    blockStart = 0;
+    token = NULL;
+    tokenLength = 0;
+    tokenLine = 0;
+    tokenColumn = 0;
+    fileBytes = 0;
+}
+
+//! open a graph description
+//! @param[in] fileName    name of the file with the graph description
+//! @return                true if the file is open
+bool DescriptionReader::open(string fileName)
+{
+    file.open(fileName.c_str(), ios::in | ios::binary);
+    if (!file)
+        return false;
+    
+    // the size bounds the number of nodes the file can describe (0 = unknown, e.g. a pipe)
+    file.seekg(0, ios::end);
+    fileBytes = file.tellg();
+    if (fileBytes < 0)
+        fileBytes = 0;
+    file.clear();
+    file.seekg(0, ios::beg);
+    file.clear();
+    
+    buffer.resize(BLOCK_BYTES);
+    position = 0;
+    filled = 0;
+    endOfFile = false;
+    line = 1;
+    lineStart = 0;
+    blockStart = 0;
+    return true;
+}
+
+//! move the characters not read yet at the beginning of the block and read more
+//! @return     false if the file has no more characters
+bool DescriptionReader::refill()
+{
+    if (endOfFile == true)
+        return false;
+    
+    // keep the characters not read yet (part of a token)
+    size_t kept = filled - position;
+    if (position > 0)
+    {
+        for (size_t i=0; i< kept; i++)
+            buffer[i] = buffer[position+i];
+        blockStart = blockStart + position;
+        position = 0;
+        filled = kept;
+    }
+    
+    // a token longer than a block enlarges it
+    if (filled == buffer.size())
+        buffer.resize(2*buffer.size());
+    
+    file.read(&buffer[filled], buffer.size() - filled);
+    size_t numRead = file.gcount();
+    if (numRead == 0)
+        endOfFile = true;
+    filled = filled + numRead;
+    return numRead > 0;
+}
+
+//! read the next token
+//! @return     false if the file has no more tokens
+bool DescriptionReader::next()
+{
+    // skip the separators, counting the lines
+    while (true)
+    {
+        if ((position == filled) && (refill() == false))
+        {
+            // the end of the file is reported where it is reached
+            token = NULL;
+            tokenLength = 0;
+            tokenLine = line;
+            tokenColumn = (int)(blockStart + position - lineStart) + 1;
+            return false;
+        }
+        char c = buffer[position];
+        if (isSeparator(c) == false)
+            break;
+        position = position + 1;
+        if (c == '\n')
+        {
+            line = line + 1;
+            lineStart = blockStart + position;
+        }
+    }
+    
+    tokenLine = line;
+    tokenColumn = (int)(blockStart + position - lineStart) + 1;
+    
+    // the token ends at the first separator (or at the end of the file)
+    size_t end = position + 1;
+    while (true)
+    {
+        if (end == filled)
+        {
+            // the block may move: the token is kept as an offset
+            size_t offset = end - position;
+            bool more = refill();
+            end = position + offset;
+            if (more == false)
+                break;
+            continue;
+        }
+        if (isSeparator(buffer[end]) == true)
+            break;
+        end = end + 1;
+    }
+    
+    token = &buffer[position];
+    tokenLength = end - position;
+    position = end;
+    return true;
+}
+
+//! read the next token as an integer
+//! @param[out] value   value of the integer
+//! @return             false if the file has no more tokens or the token is not an integer
+bool DescriptionReader::nextInt(int &value)
+{
+    if (next() == false)
+        return false;
+    
+    size_t i = 0;
+    bool negative = false;
+    if ((token[0] == '-') || (token[0] == '+'))
+    {
+        negative = (token[0] == '-');
+        i = 1;
+    }
+    if (i == tokenLength)
+        return false;
+    
+    long long result = 0;
+    for (; i< tokenLength; i++)
+    {
+        if ((token[i] < '0') || (token[i] > '9'))
+            return false;
+        result = 10*result + (token[i] - '0');
+        if (result > (long long)INT_MAX + 1)
+            return false;
+    }
+    if (negative == true)
+        result = -result;
+    if ((result > INT_MAX) || (result < INT_MIN))
+        return false;
+    
+    value = (int)result;
+    return true;
+}
@@ -0,0 +1,73 @@
+//===============================================================================//
+// Name			: descriptionreader.h
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Description	: Buffered tokenizer of the text description of an AND-OR graph
+//===============================================================================//
+
+#ifndef DESCRIPTIONREADER_H
+#define DESCRIPTIONREADER_H
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+//! class "DescriptionReader" for the tokens of a graph description
+//! N.B. the file is read in blocks, in a single pass: the tokens point into
+//! the block and are valid until the next token is read
+class DescriptionReader
+{
+    protected:
+        ifstream file;              //!< file with the graph description
+        vector<char> buffer;        //!< block of the file being read
+        size_t position;            //!< first character not read yet in the block
+        size_t filled;              //!< number of characters in the block
+        bool endOfFile;             //!< true if the whole file has been read in blocks
+        int line;                   //!< line of the first character not read yet
+        long long lineStart;        //!< offset in the file of the first character of that line
+        long long blockStart;       //!< offset in the file of the first character of the block
+        
+        //! move the characters not read yet at the beginning of the block and read more
+        bool refill();
+    
+    public:
+        const char* token;          //!< characters of the last token (not terminated, NULL = end of file)
+        size_t tokenLength;         //!< number of characters of the last token
+        int tokenLine;              //!< line of the last token (from 1)
+        int tokenColumn;            //!< column of the last token (from 1)
+        long long fileBytes;        //!< size of the file with the graph description
+        
+        //! constructor
+        DescriptionReader();
+        
+        //! open a graph description
+        bool open(string fileName);
+        
+        //! read the next token
+        bool next();
+        
+        //! read the next token as an integer
+        bool nextInt(int &value);
+        
+        //! determine whether the end of the file has been reached
+        bool endReached() const
+        {
+            return token == NULL;
+        }
+        
+        //! last token, as a string
+        string tokenText() const
+        {
+            return string(token, tokenLength);
+        }
+        
+        //! destructor
+		~DescriptionReader()
+		{
+			//DEBUG:cout<<endl <<"Destroying DescriptionReader object" <<endl;
+		}
+};
+
+#endif
@@ -0,0 +1,150 @@
+//===============================================================================//
+// Name			: endorc.cpp
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Version		: 1.0
+// Description	: Client of the planning daemon (pipelined requests from a file)
+//===============================================================================//
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <vector>
+
+#include "endorprotocol.h"
+
+using namespace std;
+
+// display the usage of the client
+void displayHelp()
+{
+    cout<<"Usage: endorc [-s <socket>] [requests file]" <<endl;
+    cout<<"  -s <socket>    path of the Unix domain socket (default " <<ENDOR_DEFAULT_SOCKET <<")" <<endl;
+    cout<<"The requests (default: standard input) are one per line, as <code> <arguments>:" <<endl;
+    cout<<"  L <graph> <file>       load a graph description" <<endl;
+    cout<<"  B <graph> <file>       load a binary image" <<endl;
+    cout<<"  U <graph>              remove a graph" <<endl;
+    cout<<"  S <graph> <node>       solve a node" <<endl;
+    cout<<"  M <graph> <node> ...   solve several nodes at once" <<endl;
+    cout<<"  N <graph> <0|1>        suggest the node to solve (1 = long-sighted)" <<endl;
+    cout<<"  F <graph>              display the nodes which can be solved now" <<endl;
+    cout<<"  W <graph> <file>       write the solve state to file" <<endl;
+    cout<<"  R <graph> <file>       restore the solve state from file" <<endl;
+    cout<<"  X                      stop the daemon" <<endl;
+    cout<<"All requests are sent before reading the replies (one line per reply, in order)." <<endl;
+}
+
+int main(int argc, char **argv)
+{
+    string socketPath = ENDOR_DEFAULT_SOCKET;
+    string requestsName;
+    for (int i=1; i< argc; i++)
+    {
+        if ((strcmp(argv[i], "-s") == 0) && (i < argc-1))
+            socketPath = argv[++i];
+        else if ((argv[i][0] != '-') && (i == argc-1))
+            requestsName = argv[i];
+        else
+        {
+            displayHelp();
+            return 1;
+        }
+    }
+    ifstream requestsFile;
+    if (requestsName.empty() == false)
+    {
+        requestsFile.open(requestsName.c_str());
+        if (!requestsFile)
+        {
+            cout<<"Unable to read the requests from " <<requestsName <<endl;
+            return 1;
+        }
+    }
+    istream &requests = (requestsName.empty() == true) ? cin : requestsFile;
+    
+    // build all request frames
+    // N.B. the solve states are written to (read from) files by the client
+    string output;
+    vector<string> stateFiles;
+    string line;
+    while (getline(requests, line))
+    {
+        if ((line.empty() == true) || (line[0] == '#'))
+            continue;
+        char code = line[0];
+        string arguments = (line.size() > 2) ? line.substr(2) : "";
+        string fileName;
+        if ((code == REQUEST_SAVE) || (code == REQUEST_RESTORE))
+        {
+            size_t space = arguments.find(' ');
+            if (space == string::npos)
+            {
+                cout<<"Missing state file: " <<line <<endl;
+                return 1;
+            }
+            fileName = arguments.substr(space+1);
+            arguments = arguments.substr(0, space);
+        }
+        if (code == REQUEST_RESTORE)
+        {
+            ifstream stateFile(fileName.c_str(), ios::in | ios::binary);
+            if (!stateFile)
+            {
+                cout<<"Unable to read the solve state from " <<fileName <<endl;
+                return 1;
+            }
+            arguments = arguments + " " + string((istreambuf_iterator<char>(stateFile)), istreambuf_iterator<char>());
+        }
+        appendFrame(output, code, arguments);
+        stateFiles.push_back((code == REQUEST_SAVE) ? fileName : "");
+    }
+    
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path)-1);
+    int server = socket(AF_UNIX, SOCK_STREAM, 0);
+    if ((server < 0) || (connect(server, (sockaddr*)&address, sizeof(address)) < 0))
+    {
+        cout<<"Unable to connect to " <<socketPath <<endl;
+        return 1;
+    }
+    
+    // send all requests at once (pipelined), then read the replies in order
+    if (writeAll(server, output) == false)
+    {
+        cout<<"Connection closed by the daemon" <<endl;
+        close(server);
+        return 1;
+    }
+    shutdown(server, SHUT_WR);
+    string input;
+    int failed = 0;
+    for (int i=0; i< (int)stateFiles.size(); i++)
+    {
+        char code;
+        string result;
+        if (readFrame(server, input, code, result) == false)
+        {
+            cout<<"Connection closed by the daemon" <<endl;
+            close(server);
+            return 1;
+        }
+        if (code != REPLY_OK)
+            failed++;
+        if ((code == REPLY_OK) && (stateFiles[i].empty() == false))
+        {
+            ofstream stateFile(stateFiles[i].c_str(), ios::out | ios::binary);
+            stateFile.write(result.data(), result.size());
+            result = "state written to " + stateFiles[i];
+        }
+        cout<<code <<" " <<result <<endl;
+    }
+    close(server);
+    
+    return (failed == 0) ? 0 : 2;
+}
@@ -0,0 +1,719 @@
+//===============================================================================//
+// Name			: endord.cpp
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Version		: 1.0
+// Description	: Planning daemon serving AND-OR graphs over a Unix domain socket
+//===============================================================================//
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <poll.h>
+#include <sstream>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <system_error>
+#include <thread>
+#include <unistd.h>
+
+#include "aograph.h"
+#include "endorprotocol.h"
+
+using namespace std;
+
+#define SHUTDOWN_TIMEOUT 5000   //!< time given to the clients to read their last replies (milliseconds)
+
+//! class "Connection" for a client of the daemon
+//! N.B. the requests are served in the order they are received, and their
+//! replies are queued in the same order: a client can send many requests
+//! without waiting for the replies (pipelining)
+class Connection
+{
+    public:
+        int cSocket;            //!< socket of the client (non-blocking)
+        int cId;                //!< identifier of the connection (never reused)
+        string cInput;          //!< bytes received, not served yet
+        string cOutput;         //!< replies not written yet
+        bool cWaiting;          //!< true while a graph is loaded for the client (its next requests wait)
+        bool cEnded;            //!< true if the client stopped sending requests (or is gone)
+        
+        //! constructor
+        Connection(int socket, int id);
+        
+        //! write the replies, as much as the socket accepts now
+        void writeReplies();
+};
+
+//! constructor of class Connection
+//! @param[in] socket   socket of the client
+//! @param[in] id       identifier of the connection
+Connection::Connection(int socket, int id)
+{
+    cSocket = socket;
+    cId = id;
+    cWaiting = false;
+    cEnded = false;
+}
+
+//! write the replies, as much as the socket accepts now
+//! N.B. the socket is never switched to blocking: a client which does not read
+//! its replies keeps them queued, without stalling the other clients
+void Connection::writeReplies()
+{
+    while (cOutput.empty() == false)
+    {
+        ssize_t written = send(cSocket, cOutput.data(), cOutput.size(), MSG_NOSIGNAL);
+        if ((written < 0) && (errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR))
+        {
+            // the client is gone: its replies are dropped
+            cOutput.clear();
+            cEnded = true;
+        }
+        if (written <= 0)
+            break;
+        cOutput.erase(0, written);
+    }
+}
+
+//! class "LoadJob" for a graph loaded on a worker thread
+//! N.B. the job only loads the graph: the daemon adds it to the loaded graphs
+//! (and replies to the client) when the job is done
+class LoadJob
+{
+    public:
+        int jConnection;        //!< identifier of the connection waiting for the reply
+        string jName;           //!< name of the graph
+        string jFile;           //!< graph description (or binary image)
+        bool jBinary;           //!< true = binary image, false = graph description
+        AOgraph* jGraph;        //!< loaded graph (NULL = not loaded)
+        string jResult;         //!< error message (if not loaded)
+        atomic<bool> jDone;     //!< true when the job is done
+        thread jThread;         //!< worker thread of the job
+        
+        //! constructor
+        LoadJob(int connection, const string &name, const string &fileName, bool binary);
+};
+
+//! constructor of class LoadJob
+//! @param[in] connection   identifier of the connection waiting for the reply
+//! @param[in] name         name of the graph
+//! @param[in] fileName     graph description (or binary image)
+//! @param[in] binary       true = binary image, false = graph description
+LoadJob::LoadJob(int connection, const string &name, const string &fileName, bool binary)
+{
+    jConnection = connection;
+    jName = name;
+    jFile = fileName;
+    jBinary = binary;
+    jGraph = NULL;
+    jDone = false;
+}
+
+//! class "PlanningDaemon" for the graphs served by the daemon
+//! N.B. the graphs are loaded on worker threads, all other requests are
+//! served one at a time by the loop of the daemon
+class PlanningDaemon
+{
+    protected:
+        map<string, AOgraph*> graphs;   //!< loaded graphs, by name
+        vector< unique_ptr<LoadJob> > jobs; //!< graphs being loaded on worker threads
+        int wakeup[2];                  //!< pipe signalling the end of a job (read end, write end)
+        PathEngine engine;              //!< engine of the graphs
+        int numThreads;                 //!< number of threads generating the paths
+        double maxPaths;                //!< budget of the paths (0 = no limit)
+        bool running;                   //!< false = shutdown requested
+        
+        //! find a loaded graph by name
+        AOgraph* findGraph(const string &name, string &error);
+        
+        //! determine whether a name can be given to a new graph
+        bool isNameFree(const string &name, string &error) const;
+        
+        //! load a graph (without adding it to the loaded graphs)
+        AOgraph* buildGraph(const string &name, const string &fileName, bool binary, string &result) const;
+        
+        //! serve a load request
+        bool load(const string &name, const string &fileName, bool binary, string &result);
+        
+        //! start serving a load request on a worker thread
+        bool startLoad(int connection, char code, const string &payload, string &result);
+        
+        //! load the graph of a job (on its worker thread)
+        void runJob(LoadJob* job);
+        
+        //! add the graphs of the jobs done to the loaded graphs, replying to their clients
+        void finishJobs(vector<Connection> &connections, bool wait);
+        
+        //! serve a solve request
+        bool solve(AOgraph &graph, const string &nameNode, string &result);
+    
+    public:
+        //! constructor
+        PlanningDaemon(PathEngine graphEngine, int threads, double paths);
+        
+        //! serve a request
+        bool serve(char code, const string &payload, string &result);
+        
+        //! accept clients and serve their requests until a shutdown request
+        bool run(const string &socketPath);
+        
+        //! destructor
+		~PlanningDaemon()
+		{
+			//DEBUG:cout<<endl <<"Destroying PlanningDaemon object" <<endl;
+            for (map<string, AOgraph*>::iterator it = graphs.begin(); it != graphs.end(); it++)
+                delete it->second;
+		}
+};
+
+//! constructor of class PlanningDaemon
+//! @param[in] graphEngine  engine of the graphs
+//! @param[in] threads      number of threads generating the paths
+//! @param[in] paths        budget of the paths (0 = no limit, over budget = solution graph engine)
+PlanningDaemon::PlanningDaemon(PathEngine graphEngine, int threads, double paths)
+{
+    engine = graphEngine;
+    numThreads = threads;
+    maxPaths = paths;
+    running = true;
+    wakeup[0] = -1;
+    wakeup[1] = -1;
+}
+
+//! find a loaded graph by name
+//! @param[in] name     name of the graph
+//! @param[out] error   error message (if not found)
+//! @return             pointer to the graph (NULL = not loaded)
+AOgraph* PlanningDaemon::findGraph(const string &name, string &error)
+{
+    map<string, AOgraph*>::iterator found = graphs.find(name);
+    if (found == graphs.end())
+    {
+        if (isNameFree(name, error) == true)
+            error = "Graph " + name + " not loaded.";
+        return NULL;
+    }
+    
+    return found->second;
+}
+
+//! determine whether a name can be given to a new graph
+//! @param[in] name     name of the graph
+//! @param[out] error   error message (if the name is taken)
+//! @return             true if no graph is loaded (or being loaded) with the name
+bool PlanningDaemon::isNameFree(const string &name, string &error) const
+{
+    if (graphs.find(name) != graphs.end())
+    {
+        error = "Graph " + name + " already loaded.";
+        return false;
+    }
+    for (int i=0; i< (int)jobs.size(); i++)
+    {
+        if (jobs[i]->jName == name)
+        {
+            error = "Graph " + name + " being loaded.";
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+//! load a graph (without adding it to the loaded graphs)
+//! N.B. only reads the settings of the daemon: it can run on a worker thread
+//! @param[in] name         name of the graph
+//! @param[in] fileName     graph description (or binary image)
+//! @param[in] binary       true = binary image, false = graph description
+//! @param[out] result      error message (if not loaded)
+//! @return                 loaded graph (NULL = not loaded)
+AOgraph* PlanningDaemon::buildGraph(const string &name, const string &fileName, bool binary, string &result) const
+{
+    // the events of the graphs are not displayed
+    // N.B. the graph is owned here until loaded: it is freed if the load throws
+    unique_ptr<AOgraph> graph(new AOgraph(name, engine));
+    graph->removeObserver(&graph->textObserver);
+    graph->setGenerationThreads(numThreads);
+    graph->setPathBudget(maxPaths, 0, true);
+    if (binary == true)
+        graph->loadFromBinary(fileName);
+    else
+        graph->loadFromFile(fileName);
+    if (graph->head == NULL)
+    {
+        result = "Unable to load " + fileName + ".";
+        return NULL;
+    }
+    
+    return graph.release();
+}
+
+//! serve a load request
+//! @param[in] name         name of the graph
+//! @param[in] fileName     graph description (or binary image)
+//! @param[in] binary       true = binary image, false = graph description
+//! @param[out] result      error message (if not loaded)
+//! @return                 true if the graph has been loaded
+bool PlanningDaemon::load(const string &name, const string &fileName, bool binary, string &result)
+{
+    if (isNameFree(name, result) == false)
+        return false;
+    
+    AOgraph* graph = buildGraph(name, fileName, binary, result);
+    if (graph == NULL)
+        return false;
+    graphs[name] = graph;
+    
+    return true;
+}
+
+//! start serving a load request on a worker thread
+//! N.B. the reply is queued when the job is done (see finishJobs())
+//! @param[in] connection   identifier of the connection of the request
+//! @param[in] code         request code (REQUEST_LOAD or REQUEST_BINARY)
+//! @param[in] payload      name of the graph, then the file to load
+//! @param[out] result      error message (if the load cannot start)
+//! @return                 true if the graph is being loaded
+bool PlanningDaemon::startLoad(int connection, char code, const string &payload, string &result)
+{
+    size_t space = payload.find(' ');
+    string name = payload.substr(0, space);
+    string fileName = (space == string::npos) ? "" : payload.substr(space+1);
+    if (isNameFree(name, result) == false)
+        return false;
+    
+    jobs.push_back(unique_ptr<LoadJob>(new LoadJob(connection, name, fileName, code == REQUEST_BINARY)));
+    try
+    {
+        jobs.back()->jThread = thread(&PlanningDaemon::runJob, this, jobs.back().get());
+    }
+    catch (const system_error &error)
+    {
+        jobs.pop_back();
+        result = "Unable to start loading " + name + ": " + error.what() + ".";
+        return false;
+    }
+    
+    return true;
+}
+
+//! load the graph of a job (on its worker thread)
+//! @param[in] job  job to run
+void PlanningDaemon::runJob(LoadJob* job)
+{
+    // N.B. an exception must not leave the worker thread (it would stop the daemon)
+    try
+    {
+        job->jGraph = buildGraph(job->jName, job->jFile, job->jBinary, job->jResult);
+    }
+    catch (const exception &error)
+    {
+        job->jGraph = NULL;
+        job->jResult = "Unable to load " + job->jFile + ": " + error.what() + ".";
+    }
+    job->jDone = true;
+    
+    // wake up the loop of the daemon
+    char signal = 1;
+    ssize_t written = write(wakeup[1], &signal, 1);
+    (void)written;
+}
+
+//! add the graphs of the jobs done to the loaded graphs, replying to their clients
+//! @param[in,out] connections  connections of the clients (replies queued, next requests served)
+//! @param[in] wait             true = wait for all jobs, false = only the jobs done
+void PlanningDaemon::finishJobs(vector<Connection> &connections, bool wait)
+{
+    for (int i = (int)jobs.size()-1; i > -1; i--)
+    {
+        LoadJob &job = *jobs[i];
+        if ((wait == false) && (job.jDone == false))
+            continue;
+        
+        job.jThread.join();
+        if (job.jGraph != NULL)
+            graphs[job.jName] = job.jGraph;
+        
+        // N.B. the client may be gone meanwhile: the graph is loaded anyway
+        for (int c=0; c< (int)connections.size(); c++)
+        {
+            if (connections[c].cId != job.jConnection)
+                continue;
+            appendFrame(connections[c].cOutput, (job.jGraph != NULL) ? REPLY_OK : REPLY_ERROR, job.jResult);
+            connections[c].cWaiting = false;
+        }
+        jobs.erase(jobs.begin() + i);
+    }
+}
+
+//! serve a solve request
+//! N.B. the node is checked here, to reply with an error instead of a message on the console
+//! @param[in] graph        graph of the node
+//! @param[in] nameNode     name of the node
+//! @param[out] result      "end" if the graph is solved, error message if the node is not solved
+//! @return                 true if the node has been solved
+bool PlanningDaemon::solve(AOgraph &graph, const string &nameNode, string &result)
+{
+    int found = graph.nameIndex.find(nameNode);
+    if (found == -1)
+        result = "Node " + nameNode + " not found.";
+    else if (graph.head->nSolved == true)
+        result = "The graph is solved.";
+    else if (graph.graph[found].nSolved == true)
+        result = "Node " + nameNode + " already solved.";
+    else if (graph.graph[found].nFeasible == false)
+        result = "Node " + nameNode + " not feasible.";
+    else
+    {
+        graph.solveById(found);
+        result = (graph.head->nSolved == true) ? "end" : "";
+        return true;
+    }
+    
+    return false;
+}
+
+//! serve a request
+//! @param[in] code     request code (see RequestCode)
+//! @param[in] payload  arguments of the request
+//! @param[out] result  result of the request, or error message
+//! @return             true if the request has been served
+bool PlanningDaemon::serve(char code, const string &payload, string &result)
+{
+    result.clear();
+    if (code == REQUEST_SHUTDOWN)
+    {
+        running = false;
+        return true;
+    }
+    
+    // all other requests start with the name of the graph
+    size_t space = payload.find(' ');
+    string name = payload.substr(0, space);
+    string arguments = (space == string::npos) ? "" : payload.substr(space+1);
+    if ((code == REQUEST_LOAD) || (code == REQUEST_BINARY))
+        return load(name, arguments, code == REQUEST_BINARY, result);
+    
+    AOgraph* graph = findGraph(name, result);
+    if (graph == NULL)
+        return false;
+    
+    switch(code)
+    {
+        case REQUEST_UNLOAD:
+            graphs.erase(name);
+            delete graph;
+            return true;
+        case REQUEST_SOLVE:
+            return solve(*graph, arguments, result);
+        case REQUEST_SOLVE_MANY:
+        {
+            // the result is the number of nodes solved
+            istringstream names(arguments);
+            vector<string> namesNodes;
+            string nameNode;
+            while (names>>nameNode)
+                namesNodes.push_back(nameNode);
+            ostringstream solved;
+            solved<<graph->solveMany(namesNodes);
+            result = solved.str();
+            return true;
+        }
+        case REQUEST_SUGGEST:
+            if (graph->head->nSolved == true)
+            {
+                result = "end";
+                return true;
+            }
+            result = graph->suggestNext(arguments != "0");
+            if (result.empty() == true)
+            {
+                result = "No suggestion possible.";
+                return false;
+            }
+            return true;
+        case REQUEST_FRONTIER:
+        {
+            vector<AOnode*> frontier = graph->getFrontier();
+            for (int i=0; i< (int)frontier.size(); i++)
+                result = result + ((i == 0) ? "" : " ") + frontier[i]->nName;
+            return true;
+        }
+        case REQUEST_SAVE:
+        {
+            vector<char> state;
+            graph->saveState(state);
+            result.assign(state.begin(), state.end());
+            return true;
+        }
+        case REQUEST_RESTORE:
+            if (graph->restoreState(vector<char>(arguments.begin(), arguments.end())) == false)
+            {
+                result = "The state does not belong to graph " + name + ".";
+                return false;
+            }
+            return true;
+        default:
+            result = string("Unknown request ") + code + ".";
+            return false;
+    }
+}
+
+//! accept clients and serve their requests until a shutdown request
+//! @param[in] socketPath   path of the Unix domain socket (replaced if it exists)
+//! @return                 false if the socket cannot be opened
+bool PlanningDaemon::run(const string &socketPath)
+{
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path))
+    {
+        ENDOR_MESSAGE("[ERROR] The socket path " <<socketPath <<" is too long.");
+        return false;
+    }
+    strcpy(address.sun_path, socketPath.c_str());
+    
+    int server = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(socketPath.c_str());
+    if ((server < 0) || (bind(server, (sockaddr*)&address, sizeof(address)) < 0) || (listen(server, 16) < 0))
+    {
+        ENDOR_MESSAGE("[ERROR] Unable to listen on " <<socketPath <<": " <<strerror(errno) <<".");
+        if (server >= 0)
+            close(server);
+        return false;
+    }
+    fcntl(server, F_SETFL, O_NONBLOCK);
+    if (pipe(wakeup) < 0)
+    {
+        ENDOR_MESSAGE("[ERROR] Unable to create the pipe of the workers: " <<strerror(errno) <<".");
+        close(server);
+        return false;
+    }
+    fcntl(wakeup[0], F_SETFL, O_NONBLOCK);
+    ENDOR_MESSAGE("[REPORT] Listening on " <<socketPath <<".");
+    
+    vector<Connection> connections;
+    int nextId = 0;
+    vector<pollfd> polled;
+    char chunk[65536];
+    while (running == true)
+    {
+        // 1. wait for a new client, requests, room to write the replies, or the end of a load
+        // N.B. a client which stopped sending is only polled to write its replies
+        polled.assign(2, pollfd());
+        polled[0].fd = server;
+        polled[0].events = POLLIN;
+        polled[1].fd = wakeup[0];
+        polled[1].events = POLLIN;
+        for (int i=0; i< (int)connections.size(); i++)
+        {
+            pollfd client;
+            client.events = (connections[i].cEnded ? 0 : POLLIN) | (connections[i].cOutput.empty() ? 0 : POLLOUT);
+            client.fd = (client.events == 0) ? -1 : connections[i].cSocket;
+            client.revents = 0;
+            polled.push_back(client);
+        }
+        if (poll(polled.data(), polled.size(), -1) < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            ENDOR_MESSAGE("[ERROR] Unable to wait for the clients: " <<strerror(errno) <<".");
+            break;
+        }
+        
+        // 2. queue the replies of the graphs loaded meanwhile
+        if ((polled[1].revents & POLLIN) != 0)
+        {
+            while (read(wakeup[0], chunk, sizeof(chunk)) > 0)
+                continue;
+            finishJobs(connections, false);
+        }
+        
+        // 3. serve all complete requests of each client, in order
+        // N.B. a load runs on a worker thread: the next requests of the client
+        // wait for its reply, the other clients are served meanwhile.
+        // The clients accepted below are polled from the next iteration
+        for (int i = (int)connections.size()-1; i > -1; i--)
+        {
+            Connection &connection = connections[i];
+            if ((polled[i+2].revents & (POLLIN | POLLHUP | POLLERR)) != 0)
+            {
+                ssize_t received;
+                while ((received = recv(connection.cSocket, chunk, sizeof(chunk), 0)) > 0)
+                    connection.cInput.append(chunk, received);
+                if ((received == 0) || ((errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR)))
+                    connection.cEnded = true;
+            }
+            
+            // N.B. a request which throws (e.g., out of memory) is answered with an
+            // error, and the daemon goes on serving: the graph of the request may
+            // be left partially updated (e.g., a node solved, not all paths updated)
+            char code;
+            string payload;
+            string result;
+            int taken = 0;
+            while ((connection.cWaiting == false) && ((taken = takeFrame(connection.cInput, code, payload)) == 1))
+            {
+                bool served = false;
+                try
+                {
+                    if ((code == REQUEST_LOAD) || (code == REQUEST_BINARY))
+                    {
+                        connection.cWaiting = startLoad(connection.cId, code, payload, result);
+                        if (connection.cWaiting == false)
+                            appendFrame(connection.cOutput, REPLY_ERROR, result);
+                        continue;
+                    }
+                    served = serve(code, payload, result);
+                }
+                catch (const exception &error)
+                {
+                    ENDOR_MESSAGE("[ERROR] Request " <<code <<" failed: " <<error.what() <<".");
+                    result = string("Request failed: ") + error.what() + ".";
+                }
+                appendFrame(connection.cOutput, served ? REPLY_OK : REPLY_ERROR, result);
+            }
+            if (taken == -1)
+            {
+                ENDOR_MESSAGE("[WARNING] Invalid request frame: closing the connection.");
+                connection.cInput.clear();
+                connection.cEnded = true;
+            }
+            
+            // 4. write the replies, then close the connection of a client which
+            //    stopped sending once all its replies are written
+            // N.B. the replies left are written when the socket has room (POLLOUT)
+            connection.writeReplies();
+            if ((connection.cEnded == true) && (connection.cWaiting == false) && (connection.cOutput.empty() == true))
+            {
+                close(connection.cSocket);
+                connections.erase(connections.begin() + i);
+            }
+        }
+        
+        // 5. accept the new clients
+        if ((polled[0].revents & POLLIN) != 0)
+        {
+            int client;
+            while ((client = accept(server, NULL, NULL)) >= 0)
+            {
+                fcntl(client, F_SETFL, O_NONBLOCK);
+                connections.push_back(Connection(client, nextId++));
+            }
+        }
+    }
+    
+    // the loads in progress are completed, then the replies not written yet
+    // (e.g., to the shutdown request) are written before closing
+    // N.B. the replies are written as the clients read them: the ones not read
+    // within SHUTDOWN_TIMEOUT are dropped
+    finishJobs(connections, true);
+    chrono::steady_clock::time_point deadline = chrono::steady_clock::now() + chrono::milliseconds(SHUTDOWN_TIMEOUT);
+    while (true)
+    {
+        polled.clear();
+        for (int i=0; i< (int)connections.size(); i++)
+        {
+            connections[i].writeReplies();
+            if (connections[i].cOutput.empty() == false)
+            {
+                pollfd client;
+                client.fd = connections[i].cSocket;
+                client.events = POLLOUT;
+                client.revents = 0;
+                polled.push_back(client);
+            }
+        }
+        int remaining = chrono::duration_cast<chrono::milliseconds>(deadline - chrono::steady_clock::now()).count();
+        if ((polled.empty() == true) || (remaining <= 0))
+            break;
+        if ((poll(polled.data(), polled.size(), remaining) < 0) && (errno != EINTR))
+            break;
+    }
+    for (int i=0; i< (int)connections.size(); i++)
+        close(connections[i].cSocket);
+    close(wakeup[0]);
+    close(wakeup[1]);
+    close(server);
+    unlink(socketPath.c_str());
+    ENDOR_MESSAGE("[REPORT] Daemon stopped.");
+    
+    return true;
+}
+
+// display the usage of the daemon
+void displayHelp()
+{
+    cout<<"Usage: endord [options]" <<endl;
+    cout<<"  -s <socket>        path of the Unix domain socket (default " <<ENDOR_DEFAULT_SOCKET <<")" <<endl;
+    cout<<"  -l <name>=<file>   load a graph description at startup (repeatable)" <<endl;
+    cout<<"  -e <engine>        engine of the graphs: paths or solution_graph (default paths)" <<endl;
+    cout<<"  -t <threads>       threads generating the paths (default 1, 0 = all hardware threads)" <<endl;
+    cout<<"  -p <paths>         budget of the paths, over budget = solution graph engine (default 0 = no limit)" <<endl;
+    cout<<"The graphs requested by the clients are loaded on worker threads; the other requests" <<endl;
+    cout<<"are served one at a time, hence a long request (e.g., solving many nodes) delays the others." <<endl;
+}
+
+int main(int argc, char **argv)
+{
+    string socketPath = ENDOR_DEFAULT_SOCKET;
+    vector<string> preload;
+    PathEngine engine = ENGINE_PATHS;
+    int numThreads = 1;
+    double maxPaths = 0;
+    
+    for (int i=1; i< argc; i++)
+    {
+        if ((strlen(argv[i]) != 2) || (argv[i][0] != '-') || (i == argc-1))
+        {
+            displayHelp();
+            return 1;
+        }
+        char option = argv[i][1];
+        char* value = argv[++i];
+        switch(option)
+        {
+            case 's':
+                socketPath = value;
+                break;
+            case 'l':
+                preload.push_back(value);
+                break;
+            case 'e':
+                engine = (strcmp(value, "solution_graph") == 0) ? ENGINE_SOLUTION_GRAPH : ENGINE_PATHS;
+                break;
+            case 't':
+                numThreads = atoi(value);
+                break;
+            case 'p':
+                maxPaths = atof(value);
+                break;
+            default:
+                displayHelp();
+                return 1;
+        }
+    }
+    
+    PlanningDaemon daemon(engine, numThreads, maxPaths);
+    for (int i=0; i< (int)preload.size(); i++)
+    {
+        size_t equal = preload[i].find('=');
+        string result;
+        if ((equal == string::npos)
+            || (daemon.serve(REQUEST_LOAD, preload[i].substr(0, equal) + " " + preload[i].substr(equal+1), result) == false))
+        {
+            cout<<"Unable to load " <<preload[i] <<". " <<result <<endl;
+            return 1;
+        }
+    }
+    
+    return (daemon.run(socketPath) == true) ? 0 : 1;
+}
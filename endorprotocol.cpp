@@ -0,0 +1,96 @@
+//===============================================================================//
+// Name			: endorprotocol.cpp
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Description	: Length-prefixed protocol of the planning daemon (Unix domain socket)
+//===============================================================================//
+
+#include <cerrno>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "endorprotocol.h"
+
+//! append a frame to a buffer: 4-byte length (network order), code, payload
+//! N.B. the length counts the code and the payload
+//! @param[out] buffer  buffer to append the frame to
+//! @param[in] code     request or reply code
+//! @param[in] payload  arguments of the request, or result of the reply
+void appendFrame(string &buffer, char code, const string &payload)
+{
+    unsigned int length = payload.size() + 1;
+    buffer.push_back((char)((length >> 24) & 0xFF));
+    buffer.push_back((char)((length >> 16) & 0xFF));
+    buffer.push_back((char)((length >> 8) & 0xFF));
+    buffer.push_back((char)(length & 0xFF));
+    buffer.push_back(code);
+    buffer.append(payload);
+}
+
+//! take the first complete frame of a buffer
+//! @param[in,out] buffer   received bytes (the frame is removed)
+//! @param[out] code        request or reply code
+//! @param[out] payload     arguments of the request, or result of the reply
+//! @return                 1 = frame taken, 0 = frame not complete yet, -1 = invalid frame
+int takeFrame(string &buffer, char &code, string &payload)
+{
+    if (buffer.size() < 4)
+        return 0;
+    
+    unsigned int length = ((unsigned int)(unsigned char)buffer[0] << 24)
+        | ((unsigned int)(unsigned char)buffer[1] << 16)
+        | ((unsigned int)(unsigned char)buffer[2] << 8) | (unsigned int)(unsigned char)buffer[3];
+    if ((length == 0) || (length > ENDOR_MAX_FRAME))
+        return -1;
+    if (buffer.size() < 4 + (size_t)length)
+        return 0;
+    
+    code = buffer[4];
+    payload.assign(buffer, 5, length-1);
+    buffer.erase(0, 4 + (size_t)length);
+    return 1;
+}
+
+//! write a whole buffer to a socket
+//! @param[in] socket   connected socket (blocking)
+//! @param[in] buffer   bytes to write
+//! @return             false if the connection has been closed
+bool writeAll(int socket, const string &buffer)
+{
+    size_t written = 0;
+    while (written < buffer.size())
+    {
+        ssize_t result = send(socket, buffer.data() + written, buffer.size() - written, MSG_NOSIGNAL);
+        if ((result < 0) && (errno == EINTR))
+            continue;
+        if (result <= 0)
+            return false;
+        written = written + result;
+    }
+    
+    return true;
+}
+
+//! read from a socket until a complete frame is available
+//! @param[in] socket       connected socket (blocking)
+//! @param[in,out] buffer   bytes received and not taken yet
+//! @param[out] code        request or reply code
+//! @param[out] payload     arguments of the request, or result of the reply
+//! @return                 false if the connection has been closed (or the frame is invalid)
+bool readFrame(int socket, string &buffer, char &code, string &payload)
+{
+    char chunk[65536];
+    while (true)
+    {
+        int taken = takeFrame(buffer, code, payload);
+        if (taken != 0)
+            return taken == 1;
+        
+        ssize_t result = recv(socket, chunk, sizeof(chunk), 0);
+        if ((result < 0) && (errno == EINTR))
+            continue;
+        if (result <= 0)
+            return false;
+        buffer.append(chunk, result);
+    }
+}
@@ -0,0 +1,56 @@
+//===============================================================================//
+// Name			: endorprotocol.h
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Description	: Length-prefixed protocol of the planning daemon (Unix domain socket)
+//===============================================================================//
+
+#ifndef ENDORPROTOCOL_H
+#define ENDORPROTOCOL_H
+
+#include <string>
+
+using namespace std;
+
+//! socket of the daemon if none is given
+#define ENDOR_DEFAULT_SOCKET "/tmp/endord.sock"
+
+//! maximum size of a frame (larger frames close the connection)
+#define ENDOR_MAX_FRAME (64 << 20)
+
+//! requests to the daemon (first byte of a request frame), with their arguments
+//! N.B. the arguments are separated by one space (node and graph names have no spaces)
+enum RequestCode
+{
+    REQUEST_LOAD = 'L',         //!< "graph file": load a graph description
+    REQUEST_BINARY = 'B',       //!< "graph file": load a binary image
+    REQUEST_UNLOAD = 'U',       //!< "graph": remove a graph
+    REQUEST_SOLVE = 'S',        //!< "graph node": solve a node
+    REQUEST_SOLVE_MANY = 'M',   //!< "graph node node ...": solve several nodes at once
+    REQUEST_SUGGEST = 'N',      //!< "graph 0|1": suggest the node to solve (1 = long-sighted)
+    REQUEST_FRONTIER = 'F',     //!< "graph": feasible nodes not solved yet
+    REQUEST_SAVE = 'W',         //!< "graph": solve state (binary)
+    REQUEST_RESTORE = 'R',      //!< "graph state": restore a solve state (binary after the space)
+    REQUEST_SHUTDOWN = 'X'      //!< "": stop the daemon
+};
+
+//! replies of the daemon (first byte of a reply frame), followed by the result or the error
+enum ReplyCode
+{
+    REPLY_OK = '+',             //!< request served, result follows
+    REPLY_ERROR = '-'           //!< request refused, error message follows
+};
+
+//! append a frame to a buffer: 4-byte length (network order), code, payload
+void appendFrame(string &buffer, char code, const string &payload);
+
+//! take the first complete frame of a buffer
+int takeFrame(string &buffer, char &code, string &payload);
+
+//! write a whole buffer to a socket
+bool writeAll(int socket, const string &buffer);
+
+//! read from a socket until a complete frame is available
+bool readFrame(int socket, string &buffer, char &code, string &payload);
+
+#endif
@@ -0,0 +1,97 @@
+//===============================================================================//
+// Name			: graphgen.cpp
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Version		: 1.0
+// Description	: Program writing synthetic AND-OR graph descriptions
+//===============================================================================//
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "graphgenerator.h"
+
+using namespace std;
+
+// display the usage of the generator
+void displayHelp()
+{
+    cout<<"Usage: endor_graphgen [options] <description file>" <<endl;
+    cout<<"  -d <depth>         levels below the head node (default 3)" <<endl;
+    cout<<"  -o <branching>     hyperarcs of each non-leaf node (default 2)" <<endl;
+    cout<<"  -a <fanout>        child nodes of each hyperarc (default 2)" <<endl;
+    cout<<"  -s <sharing>       probability of reusing a node, in [0,1] (default 0)" <<endl;
+    cout<<"  -c <distribution>  costs: constant, uniform or skewed (default uniform)" <<endl;
+    cout<<"  -m <cost>          maximum node (or hyperarc) cost (default 5)" <<endl;
+    cout<<"  -r <seed>          seed of the random generator (default 1)" <<endl;
+}
+
+int main(int argc, char **argv)
+{
+    GraphSettings settings;
+    string fileName;
+    
+    for (int i=1; i< argc; i++)
+    {
+        // the last argument is the file, all others are pairs option + value
+        if ((argv[i][0] != '-') && (i == argc-1))
+        {
+            fileName = argv[i];
+            continue;
+        }
+        if ((strlen(argv[i]) != 2) || (i == argc-1))
+        {
+            displayHelp();
+            return 1;
+        }
+        char option = argv[i][1];
+        char* value = argv[++i];
+        switch(option)
+        {
+            case 'd':
+                settings.depth = atoi(value);
+                break;
+            case 'o':
+                settings.orBranching = atoi(value);
+                break;
+            case 'a':
+                settings.andFanout = atoi(value);
+                break;
+            case 's':
+                settings.sharing = atof(value);
+                break;
+            case 'c':
+                if (strcmp(value, "constant") == 0)
+                    settings.costs = COST_CONSTANT;
+                else if (strcmp(value, "skewed") == 0)
+                    settings.costs = COST_SKEWED;
+                else
+                    settings.costs = COST_UNIFORM;
+                break;
+            case 'm':
+                settings.maxCost = atoi(value);
+                break;
+            case 'r':
+                settings.seed = strtoul(value, NULL, 10);
+                break;
+            default:
+                displayHelp();
+                return 1;
+        }
+    }
+    if (fileName.empty() == true)
+    {
+        displayHelp();
+        return 1;
+    }
+    
+    GraphGenerator generator(settings);
+    generator.generate();
+    if (generator.writeDescription(fileName) == false)
+        return 1;
+    cout<<settings.graphName() <<": " <<generator.numNodes() <<" nodes, " <<generator.numArcs()
+        <<" hyperarcs, " <<generator.countPaths() <<" paths" <<endl;
+    
+    return 0;
+}
@@ -0,0 +1,183 @@
+//===============================================================================//
+// Name			: graphgenerator.cpp
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Description	: Generator of synthetic AND-OR graph descriptions
+//===============================================================================//
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include "aoobserver.h"
+#include "graphgenerator.h"
+
+//! constructor of class GraphSettings
+GraphSettings::GraphSettings()
+{
+    depth = 3;
+    orBranching = 2;
+    andFanout = 2;
+    sharing = 0.0;
+    costs = COST_UNIFORM;
+    maxCost = 5;
+    seed = 1;
+}
+
+//! name of a graph generated with these settings
+//! @return     name listing the settings (e.g., synthetic_d3_or2_and2_share0_uniform5_seed1)
+string GraphSettings::graphName() const
+{
+    const char* distributions[] = {"constant", "uniform", "skewed"};
+    
+    ostringstream name;
+    name<<"synthetic_d" <<depth <<"_or" <<orBranching <<"_and" <<andFanout
+        <<"_share" <<(int)(sharing*100 + 0.5) <<"_" <<distributions[costs] <<maxCost <<"_seed" <<seed;
+    return name.str();
+}
+
+//! constructor of class GraphGenerator
+//! @param[in] graphSettings    shape of the graph
+GraphGenerator::GraphGenerator(const GraphSettings &graphSettings)
+{
+    settings = graphSettings;
+    random.seed(settings.seed);
+}
+
+//! draw an integer in [0, bound)
+//! N.B. the integers are computed from the raw generator, hence the same
+//! seed generates the same graph with any standard library
+//! @param[in] bound    number of possible integers
+//! @return             random integer
+int GraphGenerator::drawIndex(int bound)
+{
+    return (int)(random() % (unsigned int)bound);
+}
+
+//! draw a cost from the distribution of the settings
+//! @return     random cost in [0, maxCost]
+int GraphGenerator::drawCost()
+{
+    if (settings.costs == COST_CONSTANT)
+        return settings.maxCost;
+    if (settings.costs == COST_UNIFORM)
+        return drawIndex(settings.maxCost+1);
+    
+    // skewed: u^3 with u uniform in [0, 1) is mostly close to 0
+    double unit = random() / 4294967296.0;
+    return (int)(unit*unit*unit*(settings.maxCost+1));
+}
+
+//! generate the nodes and hyperarcs of the graph
+void GraphGenerator::generate()
+{
+    nodeCost.clear();
+    arcParent.clear();
+    arcCost.clear();
+    arcChildren.clear();
+    
+    // the head node is the only node of the first level
+    nodeCost.push_back(drawCost());
+    vector<int> level(1, 0);
+    for (int d=0; d< settings.depth; d++)
+    {
+        // the child nodes of a level are the next level: reusing them only
+        // among the nodes of the next level keeps the graph acyclic
+        vector<int> next;
+        for (int i=0; i< (int)level.size(); i++)
+        {
+            for (int a=0; a< settings.orBranching; a++)
+            {
+                vector<int> children;
+                for (int c=0; c< settings.andFanout; c++)
+                {
+                    int child = -1;
+                    if ((next.empty() == false) && (random() / 4294967296.0 < settings.sharing))
+                    {
+                        int candidate = next[drawIndex(next.size())];
+                        if (find(children.begin(), children.end(), candidate) == children.end())
+                            child = candidate;
+                    }
+                    if (child == -1)
+                    {
+                        child = nodeCost.size();
+                        nodeCost.push_back(drawCost());
+                        next.push_back(child);
+                    }
+                    children.push_back(child);
+                }
+                arcParent.push_back(level[i]);
+                arcCost.push_back(drawCost());
+                arcChildren.push_back(children);
+            }
+        }
+        level.swap(next);
+    }
+}
+
+//! write the graph description to a file
+//! @param[in] fileName     name of the file (see assemblies/TEMPLATE.txt for the format)
+//! @return                 true if the description has been written
+bool GraphGenerator::writeDescription(string fileName) const
+{
+    ofstream graphFile(fileName.c_str());
+    if (!graphFile)
+    {
+        ENDOR_MESSAGE("[ERROR] Unable to write the graph description to " <<fileName <<".");
+        return false;
+    }
+    
+    // header, nodes, then hyperarcs
+    graphFile<<settings.graphName() <<" " <<nodeCost.size() <<" n0" <<endl;
+    for (int i=0; i< (int)nodeCost.size(); i++)
+        graphFile<<"n" <<i <<" " <<nodeCost[i] <<endl;
+    for (int i=0; i< (int)arcParent.size(); i++)
+    {
+        graphFile<<arcChildren[i].size() <<" n" <<arcParent[i] <<" " <<arcCost[i] <<endl;
+        for (int j=0; j< (int)arcChildren[i].size(); j++)
+            graphFile<<"n" <<arcChildren[i][j] <<endl;
+    }
+    
+    return (bool)graphFile;
+}
+
+//! number of nodes of the generated graph
+//! @return     number of nodes
+int GraphGenerator::numNodes() const
+{
+    return nodeCost.size();
+}
+
+//! number of hyperarcs of the generated graph
+//! @return     number of hyperarcs
+int GraphGenerator::numArcs() const
+{
+    return arcParent.size();
+}
+
+//! number of paths navigating the generated graph (as generated by the paths engine)
+//! N.B. a path chooses one hyperarc for each occurrence of a node: the paths
+//! of a node are the sum over its hyperarcs of the product of the paths of
+//! the child nodes (computed from the leaves, i.e. from the last nodes)
+//! @return     number of paths (may exceed the range of the integers)
+double GraphGenerator::countPaths() const
+{
+    vector<double> nodePaths(nodeCost.size(), 0.0);
+    vector<bool> terminal(nodeCost.size(), true);
+    for (int i=0; i< (int)arcParent.size(); i++)
+        terminal[arcParent[i]] = false;
+    
+    // the hyperarcs of a node are consecutive, and the child nodes are generated after their parents
+    for (int i = (int)arcParent.size()-1; i > -1; i--)
+    {
+        double product = 1.0;
+        for (int j=0; j< (int)arcChildren[i].size(); j++)
+        {
+            int child = arcChildren[i][j];
+            product = product * (terminal[child] ? 1.0 : nodePaths[child]);
+        }
+        nodePaths[arcParent[i]] = nodePaths[arcParent[i]] + product;
+    }
+    
+    return nodeCost.empty() ? 0.0 : (terminal[0] ? 1.0 : nodePaths[0]);
+}
@@ -0,0 +1,90 @@
+//===============================================================================//
+// Name			: graphgenerator.h
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Description	: Generator of synthetic AND-OR graph descriptions
+//===============================================================================//
+
+#ifndef GRAPHGENERATOR_H
+#define GRAPHGENERATOR_H
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+//! distributions of the costs of the generated nodes and hyperarcs
+enum CostDistribution
+{
+    COST_CONSTANT,          //!< all costs equal to the maximum cost
+    COST_UNIFORM,           //!< costs uniformly distributed in [0, maximum cost]
+    COST_SKEWED             //!< mostly cheap costs, few close to the maximum cost
+};
+
+//! class "GraphSettings" for the shape of a generated graph
+class GraphSettings
+{
+    public:
+        int depth;              //!< number of levels below the head node (leaves at the last level)
+        int orBranching;        //!< number of hyperarcs of each non-leaf node
+        int andFanout;          //!< number of child nodes of each hyperarc
+        double sharing;         //!< probability of reusing an existing node as child (0 = tree)
+        CostDistribution costs; //!< distribution of the node and hyperarc costs
+        int maxCost;            //!< maximum node (or hyperarc) cost
+        unsigned int seed;      //!< seed of the random generator
+        
+        //! constructor (default: small tree with uniform costs)
+        GraphSettings();
+        
+        //! name of a graph generated with these settings
+        string graphName() const;
+};
+
+//! class "GraphGenerator" for synthetic graphs in the text format of the descriptions
+//! N.B. the nodes are generated level by level, from the head node: each
+//! non-leaf node has orBranching hyperarcs with andFanout child nodes on the
+//! next level, either new or (with probability sharing) already generated
+class GraphGenerator
+{
+    protected:
+        GraphSettings settings;         //!< shape of the graph
+        mt19937 random;                 //!< random generator
+        vector<int> nodeCost;           //!< cost of each node (node 0 = head node)
+        vector<int> arcParent;          //!< parent node of each hyperarc
+        vector<int> arcCost;            //!< cost of each hyperarc
+        vector< vector<int> > arcChildren;  //!< child nodes of each hyperarc
+        
+        //! draw a cost from the distribution of the settings
+        int drawCost();
+        
+        //! draw an integer in [0, bound)
+        int drawIndex(int bound);
+    
+    public:
+        //! constructor
+        GraphGenerator(const GraphSettings &graphSettings);
+        
+        //! generate the nodes and hyperarcs of the graph
+        void generate();
+        
+        //! write the graph description to a file
+        bool writeDescription(string fileName) const;
+        
+        //! number of nodes of the generated graph
+        int numNodes() const;
+        
+        //! number of hyperarcs of the generated graph
+        int numArcs() const;
+        
+        //! number of paths navigating the generated graph (as generated by the paths engine)
+        double countPaths() const;
+        
+        //! destructor
+		~GraphGenerator()
+		{
+			//DEBUG:cout<<endl <<"Destroying GraphGenerator object" <<endl;
+		}
+};
+
+#endif
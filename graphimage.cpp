@@ -0,0 +1,244 @@
+//===============================================================================//
+// Name			: graphimage.cpp
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Description	: Binary image of a compiled AND-OR graph (memory-mapped when loaded)
+//===============================================================================//
+
+#include <cstring>
+#include <fstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "graphimage.h"
+
+//! number of bytes of a section of characters (padded to 4 bytes)
+//! @param[in] length   number of characters
+//! @return             number of bytes of the section
+static size_t paddedBytes(size_t length)
+{
+    return (length + 3) & ~(size_t)3;
+}
+
+//! determine whether offsets are non-decreasing from 0 to a given last value
+//! @param[in] offsets  offsets to check
+//! @param[in] count    number of offsets
+//! @param[in] last     expected last offset
+//! @return             true if the offsets are consistent
+static bool validOffsets(const int* offsets, int count, int last)
+{
+    if ((offsets[0] != 0) || (offsets[count-1] != last))
+        return false;
+    for (int i=1; i< count; i++)
+        if (offsets[i] < offsets[i-1])
+            return false;
+    
+    return true;
+}
+
+//! determine whether identifiers are in a given range
+//! @param[in] values   identifiers to check
+//! @param[in] count    number of identifiers
+//! @param[in] limit    first identifier out of range
+//! @return             true if all identifiers are in [0, limit)
+static bool validIdentifiers(const int* values, int count, int limit)
+{
+    for (int i=0; i< count; i++)
+        if ((values[i] < 0) || (values[i] >= limit))
+            return false;
+    
+    return true;
+}
+
+//! constructor of class GraphImage
+GraphImage::GraphImage()
+{
+    data = NULL;
+    bytes = 0;
+    header = NULL;
+}
+
+//! check the consistency of the sections of the image
+//! @return true if the image can be used
+bool GraphImage::validate() const
+{
+    // the sections fill the image exactly
+    const ImageHeader &h = *header;
+    if ((h.iNumNodes < 0) || (h.iNumArcs < 0) || (h.iNumChildren < 0) || (h.iNumParents < 0) ||
+        (h.iGraphNameBytes < 0) || (h.iNameBytes < 0))
+        return false;
+    size_t expected = sizeof(ImageHeader) + paddedBytes(h.iGraphNameBytes) + paddedBytes(h.iNameBytes)
+        + sizeof(int)*((size_t)h.iNumNodes+1 + h.iNumNodes + h.iNumNodes+1 + 2*(size_t)h.iNumArcs
+        + h.iNumArcs+1 + h.iNumChildren + h.iNumNodes+1 + 2*(size_t)h.iNumParents);
+    if (expected != bytes)
+        return false;
+    
+    // the offsets and identifiers refer to existing entries
+    if ((h.iHead < -1) || (h.iHead >= h.iNumNodes))
+        return false;
+    
+    return validOffsets(nameOffset, h.iNumNodes+1, h.iNameBytes) &&
+        validOffsets(arcOffset, h.iNumNodes+1, h.iNumArcs) &&
+        validOffsets(childOffset, h.iNumArcs+1, h.iNumChildren) &&
+        validOffsets(parentOffset, h.iNumNodes+1, h.iNumParents) &&
+        validIdentifiers(arcIndex, h.iNumArcs, h.iNumArcs) &&
+        validIdentifiers(childNode, h.iNumChildren, h.iNumNodes) &&
+        validIdentifiers(parentNode, h.iNumParents, h.iNumNodes) &&
+        validIdentifiers(parentArc, h.iNumParents, h.iNumArcs);
+}
+
+//! map a binary image in memory
+//! @param[in] fileName     name of the file with the binary image
+//! @return                 true if the image is mapped and valid
+bool GraphImage::open(string fileName)
+{
+    close();
+    
+    int file = ::open(fileName.c_str(), O_RDONLY);
+    if (file == -1)
+    {
+        ENDOR_MESSAGE("[ERROR] Cannot open the binary image " <<fileName <<".");
+        return false;
+    }
+    struct stat info;
+    if ((fstat(file, &info) != 0) || ((size_t)info.st_size < sizeof(ImageHeader)))
+    {
+        ENDOR_MESSAGE("[ERROR] The file " <<fileName <<" is not a binary image.");
+        ::close(file);
+        return false;
+    }
+    
+    bytes = info.st_size;
+    data = mmap(NULL, bytes, PROT_READ, MAP_PRIVATE, file, 0);
+    ::close(file);
+    if (data == MAP_FAILED)
+    {
+        ENDOR_MESSAGE("[ERROR] Cannot map the binary image " <<fileName <<" in memory.");
+        data = NULL;
+        bytes = 0;
+        return false;
+    }
+    
+    header = (const ImageHeader*)data;
+    if ((memcmp(header->iMagic, IMAGE_MAGIC, sizeof(header->iMagic)) != 0) ||
+        (header->iVersion != IMAGE_VERSION))
+    {
+        ENDOR_MESSAGE("[ERROR] The file " <<fileName <<" is not a binary image (version "
+            <<IMAGE_VERSION <<").");
+        close();
+        return false;
+    }
+    
+    // locate the sections (validate() checks the size of the image before reading them)
+    const char* position = (const char*)data + sizeof(ImageHeader);
+    graphName = position;
+    position = position + paddedBytes(header->iGraphNameBytes);
+    nameOffset = (const int*)position;
+    position = position + sizeof(int)*((size_t)header->iNumNodes+1);
+    names = position;
+    position = position + paddedBytes(header->iNameBytes);
+    const int* sections = (const int*)position;
+    nodeCost = sections;
+    arcOffset = nodeCost + header->iNumNodes;
+    arcIndex = arcOffset + header->iNumNodes+1;
+    arcCost = arcIndex + header->iNumArcs;
+    childOffset = arcCost + header->iNumArcs;
+    childNode = childOffset + header->iNumArcs+1;
+    parentOffset = childNode + header->iNumChildren;
+    parentNode = parentOffset + header->iNumNodes+1;
+    parentArc = parentNode + header->iNumParents;
+    
+    if (validate() == false)
+    {
+        ENDOR_MESSAGE("[ERROR] The binary image " <<fileName <<" is corrupted.");
+        close();
+        return false;
+    }
+    
+    return true;
+}
+
+//! unmap the image
+void GraphImage::close()
+{
+    if (data != NULL)
+        munmap(data, bytes);
+    data = NULL;
+    bytes = 0;
+    header = NULL;
+}
+
+//! write a section of integers
+//! @param[in] file     file to write
+//! @param[in] values   integers to write
+static void writeInts(ofstream &file, const vector<int> &values)
+{
+    if (values.size() != 0)
+        file.write((const char*)&values[0], sizeof(int)*values.size());
+}
+
+//! write a section of characters (padded to 4 bytes)
+//! @param[in] file     file to write
+//! @param[in] text     characters to write
+static void writeChars(ofstream &file, const string &text)
+{
+    file.write(text.data(), text.size());
+    const char padding[4] = {0, 0, 0, 0};
+    file.write(padding, paddedBytes(text.size()) - text.size());
+}
+
+//! write the binary image of a compiled graph
+//! @param[in] fileName     name of the file to write
+//! @param[in] name         name of the graph
+//! @param[in] head         identifier of the head node (-1 = none)
+//! @param[in] compiled     compiled graph
+//! @return                 true if the image is written
+bool GraphImage::write(string fileName, string name, int head, const CompiledGraph &compiled)
+{
+    // intern the names of the nodes in a single section
+    string nodeNames;
+    vector<int> offsets(1, 0);
+    for (int i=0; i< compiled.numNodes; i++)
+    {
+        nodeNames.append(compiled.node[i]->nName);
+        offsets.push_back((int)nodeNames.size());
+    }
+    
+    ImageHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.iMagic, IMAGE_MAGIC, sizeof(h.iMagic));
+    h.iVersion = IMAGE_VERSION;
+    h.iNumNodes = compiled.numNodes;
+    h.iNumArcs = compiled.numArcs();
+    h.iNumChildren = (int)compiled.childNode.size();
+    h.iNumParents = (int)compiled.parentNode.size();
+    h.iHead = head;
+    h.iGraphNameBytes = (int)name.size();
+    h.iNameBytes = (int)nodeNames.size();
+    
+    ofstream file(fileName.c_str(), ios::binary);
+    if (!file)
+    {
+        ENDOR_MESSAGE("[ERROR] Cannot write the binary image " <<fileName <<".");
+        return false;
+    }
+    file.write((const char*)&h, sizeof(h));
+    writeChars(file, name);
+    writeInts(file, offsets);
+    writeChars(file, nodeNames);
+    writeInts(file, compiled.nodeCost);
+    writeInts(file, compiled.arcOffset);
+    writeInts(file, compiled.arcIndex);
+    writeInts(file, compiled.arcCost);
+    writeInts(file, compiled.childOffset);
+    writeInts(file, compiled.childNode);
+    writeInts(file, compiled.parentOffset);
+    writeInts(file, compiled.parentNode);
+    writeInts(file, compiled.parentArc);
+    file.close();
+    
+    return !file.fail();
+}
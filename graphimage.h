@@ -0,0 +1,85 @@
+//===============================================================================//
+// Name			: graphimage.h
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Description	: Binary image of a compiled AND-OR graph (memory-mapped when loaded)
+//===============================================================================//
+
+#ifndef GRAPHIMAGE_H
+#define GRAPHIMAGE_H
+
+#include <string>
+
+#include "compiledgraph.h"
+
+using namespace std;
+
+//! identifier and version of the binary image format
+#define IMAGE_MAGIC "ENDORIMG"
+#define IMAGE_VERSION 1
+
+//! class "ImageHeader" for the header of a binary image
+//! N.B. the header is followed by the sections of the image, in this order:
+//! graph name, name offsets, names, node costs, hyperarc offsets, hyperarc
+//! indices, hyperarc costs, child offsets, child nodes, parent offsets,
+//! parent nodes, parent hyperarcs (the characters are padded to 4 bytes)
+class ImageHeader
+{
+    public:
+        char iMagic[8];             //!< identifier of the format (IMAGE_MAGIC)
+        int iVersion;               //!< version of the format (IMAGE_VERSION)
+        int iNumNodes;              //!< number of nodes
+        int iNumArcs;               //!< number of hyperarcs
+        int iNumChildren;           //!< number of child nodes (over all hyperarcs)
+        int iNumParents;            //!< number of parents (over all nodes)
+        int iHead;                  //!< identifier of the head node (-1 = none)
+        int iGraphNameBytes;        //!< length of the name of the graph
+        int iNameBytes;             //!< length of all node names
+};
+
+//! class "GraphImage" for a binary image of a compiled graph, mapped in memory
+class GraphImage
+{
+    protected:
+        void* data;                 //!< mapped image (NULL = no image)
+        size_t bytes;               //!< size of the mapped image
+        
+        //! check the consistency of the sections of the image
+        bool validate() const;
+    
+    public:
+        const ImageHeader* header;  //!< header of the image
+        const char* graphName;      //!< name of the graph (not terminated)
+        const int* nameOffset;      //!< first character of each node name (numNodes+1 entries)
+        const char* names;          //!< names of the nodes (not terminated)
+        const int* nodeCost;        //!< cost of each node
+        const int* arcOffset;       //!< first hyperarc of each node (numNodes+1 entries)
+        const int* arcIndex;        //!< index of each hyperarc
+        const int* arcCost;         //!< cost of each hyperarc
+        const int* childOffset;     //!< first child node of each hyperarc (numArcs+1 entries)
+        const int* childNode;       //!< identifier of each child node
+        const int* parentOffset;    //!< first parent of each node (numNodes+1 entries)
+        const int* parentNode;      //!< identifier of each parent
+        const int* parentArc;       //!< hyperarc of the parent including the node
+        
+        //! constructor
+        GraphImage();
+        
+        //! map a binary image in memory
+        bool open(string fileName);
+        
+        //! unmap the image
+        void close();
+        
+        //! write the binary image of a compiled graph
+        static bool write(string fileName, string name, int head, const CompiledGraph &compiled);
+        
+        //! destructor
+		~GraphImage()
+		{
+			//DEBUG:cout<<endl <<"Destroying GraphImage object" <<endl;
+            close();
+		}
+};
+
+#endif
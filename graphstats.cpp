@@ -0,0 +1,72 @@
+//===============================================================================//
+// Name			: graphstats.cpp
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Description	: Statistics of the phases of an AND-OR graph (timings and counters)
+//===============================================================================//
+
+#include "graphstats.h"
+
+//! constructor of class GraphStats
+GraphStats::GraphStats()
+{
+    reset();
+}
+
+//! set all timings and counters to zero
+void GraphStats::reset()
+{
+    for (int i=0; i< NUM_PHASES; i++)
+    {
+        phaseSeconds[i] = 0.0;
+        phaseCalls[i] = 0;
+    }
+    pathsCreated = 0;
+    pathsCopied = 0;
+    nodesVisited = 0;
+    arcLookups = 0;
+    pathBytes = 0;
+}
+
+//! name of a phase
+//! @param[in] phase    phase of the life of a graph
+//! @return             name of the phase
+const char* GraphStats::phaseName(StatsPhase phase)
+{
+    const char* names[] = {"setup", "generation", "feasibility", "update", "optimal path"};
+    return (phase < NUM_PHASES) ? names[phase] : "unknown";
+}
+
+//! display the statistics
+//! @param[in] output   stream to write the statistics to
+void GraphStats::print(ostream &output) const
+{
+#if ENDOR_STATS
+    output<<"Phase (calls, ms):" <<endl;
+    for (int i=0; i< NUM_PHASES; i++)
+        output<<"  " <<phaseName((StatsPhase)i) <<": " <<phaseCalls[i] <<", "
+            <<phaseSeconds[i]*1000.0 <<endl;
+    output<<"Paths created: " <<pathsCreated <<" (copied: " <<pathsCopied <<")" <<endl;
+    output<<"Nodes visited: " <<nodesVisited <<endl;
+    output<<"Hyperarc lookups: " <<arcLookups <<endl;
+    output<<"Bytes held by the paths: " <<pathBytes <<endl;
+#else
+    output<<"Statistics not collected (compiled with ENDOR_STATS=0)." <<endl;
+#endif
+}
+
+//! constructor of class PhaseTimer
+//! @param[in] stats    statistics to update
+//! @param[in] phase    timed phase
+PhaseTimer::PhaseTimer(GraphStats &stats, StatsPhase phase): tStats(stats)
+{
+    tPhase = phase;
+    tStart = chrono::steady_clock::now();
+}
+
+//! destructor of class PhaseTimer
+PhaseTimer::~PhaseTimer()
+{
+    tStats.phaseSeconds[tPhase] += chrono::duration<double>(chrono::steady_clock::now() - tStart).count();
+    tStats.phaseCalls[tPhase]++;
+}
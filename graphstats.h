@@ -0,0 +1,84 @@
+//===============================================================================//
+// Name			: graphstats.h
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Description	: Statistics of the phases of an AND-OR graph (timings and counters)
+//===============================================================================//
+
+#ifndef GRAPHSTATS_H
+#define GRAPHSTATS_H
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+
+using namespace std;
+
+//! statistics are collected only if ENDOR_STATS is 1 (fix it at compile time with -DENDOR_STATS=[0/1])
+#ifndef ENDOR_STATS
+#define ENDOR_STATS 1
+#endif
+
+//! time a phase until the end of the scope, add to a counter (compiled out if ENDOR_STATS is 0)
+//! N.B. when compiled out, the arguments are not evaluated (sizeof only marks them as used)
+#if ENDOR_STATS
+#define ENDOR_TIME_PHASE(stats, phase) PhaseTimer phaseTimer(stats, phase)
+#define ENDOR_COUNT(counter, amount) counter += (amount)
+#else
+#define ENDOR_TIME_PHASE(stats, phase) do {} while (0)
+#define ENDOR_COUNT(counter, amount) do { (void)sizeof(amount); } while (0)
+#endif
+
+//! phases of the life of a graph
+enum StatsPhase
+{
+    PHASE_SETUP,            //!< setupGraph() (including the phases it runs)
+    PHASE_GENERATION,       //!< generatePaths()
+    PHASE_FEASIBILITY,      //!< updateNodeFeasibility() and updateParentsFeasibility()
+    PHASE_UPDATE,           //!< updatePaths()
+    PHASE_OPTIMAL_PATH,     //!< findOptimalPath()
+    NUM_PHASES              //!< number of phases
+};
+
+//! class "GraphStats" for the statistics of a graph since its last reset
+class GraphStats
+{
+    public:
+        double phaseSeconds[NUM_PHASES];    //!< wall time spent in each phase (s)
+        long long phaseCalls[NUM_PHASES];   //!< number of runs of each phase
+        long long pathsCreated;     //!< number of paths created (the head node path and its copies)
+        long long pathsCopied;      //!< number of paths created as copies of another path
+        long long nodesVisited;     //!< number of nodes visited (path generation and feasibility)
+        long long arcLookups;       //!< number of lookups of a hyperarc (in a path or between two nodes)
+        size_t pathBytes;           //!< approximate number of bytes held by the paths
+        
+        //! constructor
+        GraphStats();
+        
+        //! set all timings and counters to zero
+        void reset();
+        
+        //! name of a phase
+        static const char* phaseName(StatsPhase phase);
+        
+        //! display the statistics
+        void print(ostream &output) const;
+};
+
+//! class "PhaseTimer" for the wall time of a phase (from construction to destruction)
+class PhaseTimer
+{
+    protected:
+        GraphStats &tStats;     //!< statistics to update
+        StatsPhase tPhase;      //!< timed phase
+        chrono::steady_clock::time_point tStart;    //!< start of the phase
+    
+    public:
+        //! constructor (start of the phase)
+        PhaseTimer(GraphStats &stats, StatsPhase phase);
+        
+        //! destructor (end of the phase)
+        ~PhaseTimer();
+};
+
+#endif
@@ -0,0 +1,80 @@
+//===============================================================================//
+// Name			: kernelcheck.cpp
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Version		: 1.0
+// Description	: Check of the vectorized kernels against their scalar versions
+//===============================================================================//
+
+#include <climits>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "pathkernels.h"
+
+using namespace std;
+
+// fill an array with random values (few distinct values, to have many ties)
+void fillValues(vector<int> &values, int count, mt19937 &generator)
+{
+    static const int special[] = {INT_MIN, INT_MAX, -1, 0, 1};
+    uniform_int_distribution<int> range(0, 3);
+    int spread = 1 << (4 * range(generator));
+    uniform_int_distribution<int> value(-spread, spread);
+    uniform_int_distribution<int> choice(0, 63);
+    
+    values.resize(count);
+    for (int i=0; i< count; i++)
+    {
+        int pick = choice(generator);
+        values[i] = (pick < 5) ? special[pick] : value(generator);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int numArrays = (argc > 1) ? atoi(argv[1]) : 20000;
+    mt19937 generator(1);
+    uniform_int_distribution<int> shortSize(0, 100);
+    uniform_int_distribution<int> longSize(0, 5000);
+    uniform_int_distribution<int> offset(0, 7);
+    
+#if ENDOR_AVX2
+    bool avx2 = vectorKernels();
+#else
+    bool avx2 = false;
+#endif
+    if (avx2 == false)
+        cout<<"[REPORT] AVX2 kernels not available: checking the scalar fallback only." <<endl;
+    
+    // each array starts at a random offset, to check the unaligned loads
+    int failed = 0;
+    vector<int> values;
+    for (int i=0; i< numArrays; i++)
+    {
+        int first = offset(generator);
+        int count = (i % 10 == 0) ? longSize(generator) : shortSize(generator);
+        fillValues(values, first + count, generator);
+        
+        int expected = findMinimumScalar(values.data() + first, count);
+        int found = findMinimum(values.data() + first, count);
+#if ENDOR_AVX2
+        if ((avx2 == true) && (found == expected))
+            found = findMinimumAVX2(values.data() + first, count);
+#endif
+        if (found != expected)
+        {
+            if (failed < 10)
+                cout<<"[ERROR] Array " <<i <<" (" <<count <<" values at offset " <<first
+                    <<"): minimum at " <<found <<" instead of " <<expected <<"." <<endl;
+            failed++;
+        }
+    }
+    
+    cout<<"[REPORT] " <<numArrays - failed <<"/" <<numArrays <<" arrays: same minimum position"
+        <<(avx2 ? " with AVX2 and scalar kernels." : ".") <<endl;
+    
+    return (failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,84 @@
+//===============================================================================//
+// Name			: loadcheck.cpp
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Version		: 1.0
+// Description	: Check of the loading of graph descriptions which must be rejected
+//===============================================================================//
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+#include "aograph.h"
+
+using namespace std;
+
+//! class "RejectedGraph" for a description which must leave the graph empty
+class RejectedGraph
+{
+    public:
+        string name;            //!< what is wrong with the description
+        string description;     //!< text of the description
+};
+
+// check that a description leaves the graph empty, and that the empty graph can be used
+bool checkRejected(const RejectedGraph &rejected, PathEngine engine, bool fallback, bool binary)
+{
+    string fileName = "loadcheck_graph.txt";
+    string imageName = "loadcheck_graph.bin";
+    ofstream descriptionFile(fileName.c_str());
+    descriptionFile<<rejected.description;
+    descriptionFile.close();
+    
+    AOgraph graph("LOADCHECK", engine);
+    graph.removeObserver(&graph.textObserver);
+    graph.setPathBudget(0, 0, fallback);
+    if (binary == false)
+        graph.loadFromFile(fileName);
+    else if (AOgraph::compileDescription(fileName, imageName) == true)
+        graph.loadFromBinary(imageName);
+    remove(fileName.c_str());
+    remove(imageName.c_str());
+    
+    // the empty graph answers without suggestions
+    string suggestion = graph.suggestNext(true) + graph.suggestNext(false);
+    if ((graph.head != NULL) || (graph.graph.size() != 0) || (suggestion.empty() == false))
+    {
+        cout<<"[ERROR] " <<rejected.name <<" (engine " <<engine <<", fallback " <<fallback
+            <<", binary " <<binary <<"): the graph is loaded." <<endl;
+        return false;
+    }
+    
+    return true;
+}
+
+int main()
+{
+    RejectedGraph rejected[] = {
+        {"cycle through the head node", "cycle 3 a\na 1\nb 1\nc 1\n1 a 1\nb\n1 b 1\nc\n1 c 1\na\n"},
+        {"cycle below the head node", "cycle 3 a\na 1\nb 1\nc 1\n1 a 1\nb\n1 a 2\nc\n1 b 1\nc\n1 c 1\nb\n"},
+        {"node child of itself", "loop 2 a\na 1\nb 1\n2 a 1\nb\na\n"},
+        {"more nodes declared than found", "count 2000000000 a\na 1\n"},
+        {"more nodes declared than memory", "count 300000000 a\na 1\n"},
+        {"more nodes found than declared", "count 1 a\na 1\nb 1\n1 a 1\nb\n"}
+    };
+    int numRejected = sizeof(rejected) / sizeof(RejectedGraph);
+    
+    // every engine, with and without the fallback over budget, from text and binary image
+    int failed = 0;
+    int numChecks = 0;
+    for (int i=0; i< numRejected; i++)
+        for (int engine = ENGINE_PATHS; engine <= ENGINE_SOLUTION_GRAPH; engine++)
+            for (int fallback = 0; fallback < 2; fallback++)
+                for (int binary = 0; binary < 2; binary++)
+                {
+                    numChecks++;
+                    if (checkRejected(rejected[i], (PathEngine)engine, fallback == 1, binary == 1) == false)
+                        failed++;
+                }
+    
+    cout<<"[REPORT] " <<numChecks - failed <<"/" <<numChecks <<" invalid descriptions rejected." <<endl;
+    
+    return (failed == 0) ? 0 : 1;
+}
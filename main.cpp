@@ -9,6 +9,7 @@
 #include <iostream>
 
 #include "aograph.h"
+#include "stateoverlay.h"
 
 using namespace std;
 
@@ -27,6 +28,8 @@ int main(int argc, char **argv)
 {
     char c;
     char c_strategy;
+    int numPaths;
+    int numThreads;
     string fileName;
     string nodeName;
     
@@ -41,9 +44,22 @@ int main(int argc, char **argv)
         cout<<endl;
         cout<<"Available commands:" <<endl;
         cout<<"H - display the ENDOR help" <<endl;
+        cout<<"T - set the number of threads generating the paths" <<endl;
+        cout<<"U - set the budget of the paths (before loading a graph)" <<endl;
         cout<<"L - load a graph description from file" <<endl;
+        cout<<"C - compile a graph description into a binary image" <<endl;
+        cout<<"B - load a graph from a binary image" <<endl;
         cout<<"N - ask for a suggestion on the node to solve" <<endl;
+        cout<<"Q - ask for a suggestion as if some nodes were solved (what-if)" <<endl;
+        cout<<"O - ask for a suggestion by Monte Carlo rollouts" <<endl;
         cout<<"S - set a node as solved" <<endl;
+        cout<<"M - set several nodes as solved at once" <<endl;
+        cout<<"D - change the cost of a node or of one of its hyperarcs" <<endl;
+        cout<<"K - display the k best paths" <<endl;
+        cout<<"F - display the nodes which can be solved now" <<endl;
+        cout<<"W - write the solve state to file" <<endl;
+        cout<<"R - restore the solve state from file" <<endl;
+        cout<<"P - display the statistics of the phases (then reset them)" <<endl;
         cout<<"E - exit the program" <<endl;
         cout<<"Selected command: ";
         cin>>c;
@@ -54,21 +70,152 @@ int main(int argc, char **argv)
             case 'H':
                 displayHelp();
                 break;
+            case 'T':
+                cout<<"Number of threads (0 = all hardware threads): ";
+                cin>>numThreads;
+                oneGraph.setGenerationThreads(numThreads);
+                break;
+            case 'U':
+            {
+                double maxPaths;
+                double maxBytes;
+                cout<<"Maximum number of paths (0 = no limit): ";
+                cin>>maxPaths;
+                cout<<"Maximum bytes held by the paths (0 = no limit): ";
+                cin>>maxBytes;
+                cout<<"[Y/N] Over budget, use the solution graph engine? ";
+                cin>>c_strategy;
+                oneGraph.setPathBudget(maxPaths, maxBytes, c_strategy == 'Y');
+                break;
+            }
             case 'L':
                 cout<<"Graph configuration: ";
                 cin>>fileName;
                 oneGraph.loadFromFile(fileName);
                 break;
+            case 'C':
+            {
+                cout<<"Graph configuration: ";
+                cin>>fileName;
+                string binaryName;
+                cout<<"Binary image: ";
+                cin>>binaryName;
+                if (AOgraph::compileDescription(fileName, binaryName) == true)
+                    cout<<"Binary image written to " <<binaryName <<endl;
+                break;
+            }
+            case 'B':
+                cout<<"Binary image: ";
+                cin>>fileName;
+                oneGraph.loadFromBinary(fileName);
+                break;
             case 'N':
                 cout<<"[Y/N] Use long-sighted (optimal path) strategy? ";
                 cin>>c_strategy;
                 oneGraph.suggestNext(c_strategy == 'Y');
                 break;
+            case 'O':
+            {
+                int numRollouts;
+                cout<<"Number of rollouts: ";
+                cin>>numRollouts;
+                oneGraph.suggestByRollouts(numRollouts, oneGraph.gThreads);
+                break;
+            }
+            case 'Q':
+            {
+                int numNodes;
+                cout<<"Number of nodes supposed solved: ";
+                cin>>numNodes;
+                StateOverlay overlay(oneGraph);
+                for (int i=0; i< numNodes; i++)
+                {
+                    cout<<"Supposed solved node name: ";
+                    cin>>nodeName;
+                    overlay.solveByName(nodeName);
+                }
+                cout<<"[Y/N] Use long-sighted (optimal path) strategy? ";
+                cin>>c_strategy;
+                cout<<"Suggested node: " <<overlay.suggestNext(c_strategy == 'Y') <<endl;
+                break;
+            }
             case 'S':
                 cout<<"Solved node name: ";
                 cin>>nodeName;
                 oneGraph.solveByName(nodeName);
                 break;
+            case 'M':
+            {
+                int numNodes;
+                cout<<"Number of solved nodes: ";
+                cin>>numNodes;
+                vector<string> nodeNames;
+                for (int i=0; i< numNodes; i++)
+                {
+                    cout<<"Solved node name: ";
+                    cin>>nodeName;
+                    nodeNames.push_back(nodeName);
+                }
+                oneGraph.solveMany(nodeNames);
+                break;
+            }
+            case 'D':
+            {
+                int hIndex;
+                int cost;
+                cout<<"Node name: ";
+                cin>>nodeName;
+                cout<<"Hyperarc index (-1 = the node itself): ";
+                cin>>hIndex;
+                cout<<"New cost: ";
+                cin>>cost;
+                if (hIndex == -1)
+                    oneGraph.setNodeCost(nodeName, cost);
+                else
+                    oneGraph.setArcCost(nodeName, hIndex, cost);
+                break;
+            }
+            case 'K':
+            {
+                cout<<"Number of paths: ";
+                cin>>numPaths;
+                vector<Path> best = oneGraph.findBestPaths(numPaths);
+                for (int i=0; i< (int)best.size(); i++)
+                    best[i].printPathInfo();
+                break;
+            }
+            case 'F':
+            {
+                vector<AOnode*> frontier = oneGraph.getFrontier();
+                for (int i=0; i< (int)frontier.size(); i++)
+                    cout<<frontier[i]->nName <<endl;
+                break;
+            }
+            case 'W':
+            {
+                cout<<"Solve state file: ";
+                cin>>fileName;
+                vector<char> state;
+                oneGraph.saveState(state);
+                ofstream stateFile(fileName.c_str(), ios::out | ios::binary);
+                stateFile.write(state.data(), state.size());
+                if (!stateFile)
+                    cout<<"Unable to write the solve state to " <<fileName <<endl;
+                break;
+            }
+            case 'R':
+            {
+                cout<<"Solve state file: ";
+                cin>>fileName;
+                ifstream stateFile(fileName.c_str(), ios::in | ios::binary);
+                vector<char> state((istreambuf_iterator<char>(stateFile)), istreambuf_iterator<char>());
+                oneGraph.restoreState(state);
+                break;
+            }
+            case 'P':
+                oneGraph.getStats().print(cout);
+                oneGraph.resetStats();
+                break;
             case 'E':
                 return 1;
         }
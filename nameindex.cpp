@@ -0,0 +1,121 @@
+//===============================================================================//
+// Name			: nameindex.cpp
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Description	: Index of the nodes of an AND-OR graph by name (open addressing)
+//===============================================================================//
+
+#include <cstring>
+
+#include "nameindex.h"
+
+//! minimum number of slots of the table
+#define MIN_SLOTS 16
+
+//! constructor of class NameIndex
+//! @param[in] graph    nodes whose names are indexed
+NameIndex::NameIndex(const NodeArena* graph)
+{
+    numNames = 0;
+    nodes = graph;
+}
+
+//! hash of a name (FNV-1a)
+//! @param[in] name     characters of the name
+//! @param[in] length   number of characters
+//! @return             hash of the name
+unsigned int NameIndex::hashName(const char* name, size_t length)
+{
+    unsigned int hash = 2166136261u;
+    for (size_t i=0; i< length; i++)
+    {
+        hash = hash ^ (unsigned char)name[i];
+        hash = hash * 16777619u;
+    }
+    
+    return hash;
+}
+
+//! find the slot of a name (the slot is empty if the name is not indexed)
+//! @param[in] name     characters of the name
+//! @param[in] length   number of characters
+//! @return             slot of the name
+int NameIndex::findSlot(const char* name, size_t length) const
+{
+    int mask = (int)slots.size() - 1;
+    int slot = (int)(hashName(name, length) & mask);
+    while (slots[slot] != -1)
+    {
+        const string &other = (*nodes)[slots[slot]].nName;
+        if ((other.size() == length) && (memcmp(other.data(), name, length) == 0))
+            break;
+        slot = (slot + 1) & mask;
+    }
+    
+    return slot;
+}
+
+//! resize the table, keeping the indexed names
+//! @param[in] capacity     number of slots (power of 2)
+void NameIndex::resize(int capacity)
+{
+    vector<int> old;
+    old.swap(slots);
+    slots.assign(capacity, -1);
+    for (int i=0; i< (int)old.size(); i++)
+    {
+        if (old[i] == -1)
+            continue;
+        const string &name = (*nodes)[old[i]].nName;
+        slots[findSlot(name.data(), name.size())] = old[i];
+    }
+}
+
+//! find the identifier of a node by name
+//! @param[in] name     characters of the name
+//! @param[in] length   number of characters
+//! @return             identifier of the node (-1 = not found)
+int NameIndex::find(const char* name, size_t length) const
+{
+    if (numNames == 0)
+        return -1;
+    
+    return slots[findSlot(name, length)];
+}
+
+//! index the name of a node
+//! @param[in] id   identifier of the node
+//! @return         false if another node has the same name
+bool NameIndex::insert(int id)
+{
+    // keep the table at most half full
+    if (2*(numNames+1) > (int)slots.size())
+        reserve(numNames+1);
+    
+    const string &name = (*nodes)[id].nName;
+    int slot = findSlot(name.data(), name.size());
+    if (slots[slot] != -1)
+        return false;
+    
+    slots[slot] = id;
+    numNames = numNames + 1;
+    return true;
+}
+
+//! reserve the space for a number of names
+//! @param[in] capacity     expected number of names
+void NameIndex::reserve(int capacity)
+{
+    int numSlots = MIN_SLOTS;
+    while (numSlots < 2*capacity)
+        numSlots = 2*numSlots;
+    if (numSlots > (int)slots.size())
+        resize(numSlots);
+}
+
+//! remove all names
+void NameIndex::clear()
+{
+    slots.clear();
+    numNames = 0;
+}
@@ -0,0 +1,71 @@
+//===============================================================================//
+// Name			: nameindex.h
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Description	: Index of the nodes of an AND-OR graph by name (open addressing)
+//===============================================================================//
+
+#ifndef NAMEINDEX_H
+#define NAMEINDEX_H
+
+#include <string>
+
+#include "nodearena.h"
+
+using namespace std;
+
+//! class "NameIndex" for the index of the nodes of a graph by name
+//! N.B. the index is a flat table of node identifiers (linear probing): the
+//! names are not copied, they are compared with the names of the nodes
+class NameIndex
+{
+    protected:
+        vector<int> slots;          //!< identifier of the node in each slot (-1 = empty)
+        int numNames;               //!< number of names in the index
+        const NodeArena* nodes;     //!< nodes whose names are indexed
+        
+        //! find the slot of a name (the slot is empty if the name is not indexed)
+        int findSlot(const char* name, size_t length) const;
+        
+        //! resize the table, keeping the indexed names
+        void resize(int capacity);
+        
+    public:
+        //! constructor
+        NameIndex(const NodeArena* graph);
+        
+        //! hash of a name
+        static unsigned int hashName(const char* name, size_t length);
+        
+        //! find the identifier of a node by name
+        int find(const char* name, size_t length) const;
+        
+        //! find the identifier of a node by name
+        int find(const string &name) const
+        {
+            return find(name.data(), name.size());
+        }
+        
+        //! index the name of a node
+        bool insert(int id);
+        
+        //! reserve the space for a number of names
+        void reserve(int capacity);
+        
+        //! remove all names
+        void clear();
+        
+        //! number of names in the index
+        int size() const
+        {
+            return numNames;
+        }
+        
+        //! destructor
+		~NameIndex()
+		{
+			//DEBUG:cout<<endl <<"Destroying NameIndex object" <<endl;
+		}
+};
+
+#endif
@@ -0,0 +1,76 @@
+//===============================================================================//
+// Name			: nodearena.cpp
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Description	: Stable storage of the nodes of an AND-OR graph
+//===============================================================================//
+
+#include "nodearena.h"
+
+//! default number of nodes in a block (log2)
+#define DEFAULT_BLOCK_BITS 8
+
+//! maximum number of nodes in a block (log2): larger arenas use several blocks
+#define MAX_BLOCK_BITS 20
+
+//! constructor of class NodeArena
+NodeArena::NodeArena()
+{
+    blockBits = DEFAULT_BLOCK_BITS;
+    blockMask = (1 << blockBits) - 1;
+    numNodes = 0;
+}
+
+//! add an empty block of nodes
+void NodeArena::addBlock()
+{
+    // the block is reserved once: adding nodes to it never reallocates it
+    // N.B. growing "blocks" moves the vectors, not the nodes they hold
+    blocks.push_back(vector<AOnode>());
+    blocks.back().reserve(1 << blockBits);
+}
+
+//! reserve the space for the nodes (only when the arena is empty)
+//! @param[in] capacity     expected number of nodes
+void NodeArena::reserve(int capacity)
+{
+    // the size of the blocks cannot change once nodes are stored
+    if (numNodes != 0)
+        return;
+    
+    // raise an error if the capacity is negative
+    if (capacity < 0)
+    {
+        ENDOR_MESSAGE("[ERROR] Invalid number of nodes " <<capacity <<".");
+        return;
+    }
+    
+    // a single block holds all the expected nodes (contiguous in memory), up
+    // to MAX_BLOCK_BITS: the blocks are reserved as a whole when added
+    blockBits = DEFAULT_BLOCK_BITS;
+    while ((blockBits < MAX_BLOCK_BITS) && ((1 << blockBits) < capacity))
+        blockBits = blockBits + 1;
+    blockMask = (1 << blockBits) - 1;
+    blocks.clear();
+}
+
+//! add a node
+//! @param[in] node     node to add
+//! @return             pointer to the stored node (valid until the arena is cleared)
+AOnode* NodeArena::push_back(const AOnode &node)
+{
+    if ((numNodes >> blockBits) == (int)blocks.size())
+        addBlock();
+    
+    blocks.back().push_back(node);
+    numNodes = numNodes + 1;
+    
+    return &blocks.back().back();
+}
+
+//! remove all nodes
+void NodeArena::clear()
+{
+    blocks.clear();
+    numNodes = 0;
+}
@@ -0,0 +1,68 @@
+//===============================================================================//
+// Name			: nodearena.h
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Description	: Stable storage of the nodes of an AND-OR graph
+//===============================================================================//
+
+#ifndef NODEARENA_H
+#define NODEARENA_H
+
+#include "aonode.h"
+
+using namespace std;
+
+//! class "NodeArena" for the stable storage of the nodes of an AND-OR graph
+//! N.B. the nodes are stored in blocks which are never reallocated: adding a node
+//! never moves the other ones, hence the pointers to the nodes (hyperarcs, parents,
+//! paths) stay valid. A node is identified by its position (AOnode::nId).
+class NodeArena
+{
+    protected:
+        vector< vector<AOnode> > blocks;    //!< blocks of contiguous nodes
+        int blockBits;          //!< log2 of the number of nodes in a block
+        int blockMask;          //!< mask of the position of a node in its block
+        int numNodes;           //!< number of nodes in the arena
+        
+        //! add an empty block of nodes
+        void addBlock();
+        
+    public:
+        //! constructor
+        NodeArena();
+        
+        //! reserve the space for the nodes (only when the arena is empty)
+        void reserve(int capacity);
+        
+        //! add a node
+        AOnode* push_back(const AOnode &node);
+        
+        //! remove all nodes
+        void clear();
+        
+        //! number of nodes in the arena
+        size_t size() const
+        {
+            return numNodes;
+        }
+        
+        //! access a node by identifier
+        AOnode& operator[](int index)
+        {
+            return blocks[index >> blockBits][index & blockMask];
+        }
+        
+        //! access a node by identifier
+        const AOnode& operator[](int index) const
+        {
+            return blocks[index >> blockBits][index & blockMask];
+        }
+        
+        //! destructor
+		~NodeArena()
+		{
+			//DEBUG:cout<<endl <<"Destroying NodeArena object" <<endl;
+		}
+};
+
+#endif
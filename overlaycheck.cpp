@@ -0,0 +1,146 @@
+//===============================================================================//
+// Name			: overlaycheck.cpp
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Version		: 1.0
+// Description	: Check of the state overlays against copies of the graph
+//===============================================================================//
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+#include "aograph.h"
+#include "graphgenerator.h"
+#include "stateoverlay.h"
+
+using namespace std;
+
+// load a graph without displaying its events
+void loadQuiet(AOgraph &graph, const string &fileName)
+{
+    graph.removeObserver(&graph.textObserver);
+    graph.loadFromFile(fileName);
+}
+
+// check that an overlay answers as a copy of the graph with the same nodes solved
+int checkSame(StateOverlay &overlay, AOgraph &copy, const string &what)
+{
+    int failed = 0;
+    for (int i=0; i< copy.paths.size(); i++)
+    {
+        if (overlay.pathCost(i) != copy.paths.costs[i])
+        {
+            cout<<"[ERROR] " <<what <<": the cost of path " <<i <<" differs." <<endl;
+            failed++;
+            break;
+        }
+    }
+    for (int i=0; i< (int)copy.graph.size(); i++)
+    {
+        if ((overlay.isSolved(i) != copy.graph[i].nSolved) || (overlay.isFeasible(i) != copy.graph[i].nFeasible))
+        {
+            cout<<"[ERROR] " <<what <<": the state of node " <<copy.graph[i].nName <<" differs." <<endl;
+            failed++;
+            break;
+        }
+    }
+    if (copy.head->nSolved == true)
+        return failed;
+    
+    if (overlay.findOptimalPath() != copy.paths.findCheapest())
+    {
+        cout<<"[ERROR] " <<what <<": the optimal paths differ." <<endl;
+        failed++;
+    }
+    if ((overlay.suggestNext(true) != copy.suggestNext(true)) || (overlay.suggestNext(false) != copy.suggestNext(false)))
+    {
+        cout<<"[ERROR] " <<what <<": the suggestions differ." <<endl;
+        failed++;
+    }
+    
+    return failed;
+}
+
+// check the overlays of one graph, while solving it
+// N.B. a copy of the graph is loaded again, then solves the same nodes as
+// the graph and the hypotheses of the overlay
+int checkGraph(const string &fileName, unsigned int seed)
+{
+    AOgraph graph("GRAPH");
+    loadQuiet(graph, fileName);
+    mt19937 generator(seed);
+    int failed = 0;
+    vector<int> solved;
+    for (int step = 0; graph.head->nSolved == false; step++)
+    {
+        // several hypotheses of 1 to 4 nodes on the current state of the graph
+        vector<int> costs = graph.paths.costs;
+        size_t numChecks = graph.paths.checks.size();
+        vector<int> indices = graph.pIndices;
+        for (int h=0; h< 4; h++)
+        {
+            StateOverlay overlay(graph);
+            AOgraph copy("COPY");
+            loadQuiet(copy, fileName);
+            for (int i=0; i< (int)solved.size(); i++)
+                copy.solveById(solved[i]);
+            int numNodes = 1 + generator() % 4;
+            for (int i=0; (i < numNodes) && (copy.head->nSolved == false); i++)
+            {
+                vector<AOnode*> frontier = copy.getFrontier();
+                int idNode = frontier[generator() % frontier.size()]->nId;
+                copy.solveById(idNode);
+                overlay.solveById(idNode);
+            }
+            failed = failed + checkSame(overlay, copy, fileName + " after " + to_string(step)
+                + " solved nodes, hypothesis " + to_string(h));
+        }
+        
+        // the hypotheses do not change the graph
+        if ((graph.paths.costs != costs) || (graph.paths.checks.size() != numChecks) || (graph.pIndices != indices))
+        {
+            cout<<"[ERROR] " <<fileName <<" after " <<step <<" solved nodes: an overlay changed the graph." <<endl;
+            failed++;
+        }
+        
+        vector<AOnode*> frontier = graph.getFrontier();
+        solved.push_back(frontier[generator() % frontier.size()]->nId);
+        graph.solveById(solved.back());
+    }
+    
+    return failed;
+}
+
+int main(int argc, char **argv)
+{
+    int numGraphs = (argc > 1) ? atoi(argv[1]) : 8;
+    int failed = 0;
+    int numChecked = 0;
+    for (int i=0; i< numGraphs; i++)
+    {
+        // trees and graphs with shared nodes
+        GraphSettings settings;
+        settings.depth = 2 + (i / 2) % 2;
+        settings.orBranching = 2 + (i / 4) % 2;
+        settings.andFanout = 2;
+        settings.sharing = (i % 2 == 0) ? 0.0 : 0.4;
+        settings.seed = i+1;
+        GraphGenerator generator(settings);
+        generator.generate();
+        if (generator.countPaths() > 1000)
+            continue;
+        string fileName = "overlaycheck_" + settings.graphName() + ".txt";
+        if (generator.writeDescription(fileName) == false)
+            return 1;
+        
+        failed = failed + checkGraph(fileName, settings.seed);
+        numChecked++;
+        remove(fileName.c_str());
+    }
+    
+    cout<<"[REPORT] " <<numChecked <<" graphs: " <<failed <<" failed checks of the overlays." <<endl;
+    
+    return (failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,179 @@
+//===============================================================================//
+// Name			: pathcheck.cpp
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Version		: 1.0
+// Description	: Check of the optimal path and of the path order of all engines
+//===============================================================================//
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+#include "aograph.h"
+#include "graphgenerator.h"
+#include "pathiterator.h"
+
+using namespace std;
+
+// load a graph without displaying its events
+void loadQuiet(AOgraph &graph, const string &fileName)
+{
+    graph.removeObserver(&graph.textObserver);
+    graph.loadFromFile(fileName);
+}
+
+// determine whether two paths choose the same hyperarcs and have the same cost
+bool samePath(const Path &path, const Path &other)
+{
+    return (path.pathArcs == other.pathArcs) && (path.pCost == other.pCost);
+}
+
+// display the hyperarcs and cost of a path
+string describe(const Path &path)
+{
+    string text = "arcs";
+    for (int i=0; i< (int)path.pathArcs.size(); i++)
+        text = text + " " + to_string(path.pathArcs[i]);
+    
+    return text + ", cost " + to_string(path.pCost);
+}
+
+// check that the iterator returns the paths in increasing cost, then index order
+int checkOrder(AOgraph &graph, const string &what)
+{
+    // the paths of the graph, sorted by cost (the sort is stable: same cost = index order)
+    vector<int> order(graph.paths.size());
+    for (int i=0; i< (int)order.size(); i++)
+        order[i] = i;
+    stable_sort(order.begin(), order.end(), [&graph](int a, int b) {
+        return graph.paths.costs[a] < graph.paths.costs[b];
+    });
+    
+    PathIterator iterator(graph);
+    Path path(0, 0);
+    for (int i=0; i< (int)order.size(); i++)
+    {
+        Path expected = graph.paths[order[i]];
+        if ((iterator.next(path) == false) || (samePath(path, expected) == false))
+        {
+            cout<<"[ERROR] " <<what <<": path " <<i <<" of the iterator is not path " <<order[i]
+                <<" (" <<describe(expected) <<")." <<endl;
+            return 1;
+        }
+    }
+    if (iterator.next(path) == true)
+    {
+        cout<<"[ERROR] " <<what <<": the iterator returns more paths than the graph has." <<endl;
+        return 1;
+    }
+    
+    return 0;
+}
+
+// check that all engines choose the same optimal path
+// N.B. the iterator and the solution graph engine subtract the benefit of a
+// solved node from its hyperarcs, the paths engine from the paths, once per
+// occurrence of the parent node: when a parent node appears several times in
+// a path (shared nodes), the paths engine is only checked before solving nodes
+int checkOptimal(AOgraph &paths, AOgraph &solution, bool samePaths, const string &what)
+{
+    int failed = 0;
+    vector<Path> best = paths.findBestPaths(1);
+    if (best.size() != 1)
+    {
+        cout<<"[ERROR] " <<what <<": the iterator returns no path." <<endl;
+        return 1;
+    }
+    
+    solution.suggestNext(true);
+    if (samePath(solution.optimalPath, best[0]) == false)
+    {
+        cout<<"[ERROR] " <<what <<": the solution graph engine chooses " <<describe(solution.optimalPath)
+            <<" instead of " <<describe(best[0]) <<"." <<endl;
+        failed++;
+    }
+    if (samePaths == false)
+        return failed;
+    
+    Path expected = paths.paths[paths.paths.findCheapest()];
+    if (samePath(best[0], expected) == false)
+    {
+        cout<<"[ERROR] " <<what <<": the first path of the iterator is not the optimal path ("
+            <<describe(expected) <<")." <<endl;
+        failed++;
+    }
+    if (paths.suggestNext(true) != solution.suggestNext(true))
+    {
+        cout<<"[ERROR] " <<what <<": the engines suggest different nodes." <<endl;
+        failed++;
+    }
+    
+    return failed;
+}
+
+// check the engines on one graph, at load and while solving it
+int checkGraph(const string &fileName, bool tree, unsigned int seed)
+{
+    AOgraph paths("PATHS", ENGINE_PATHS);
+    AOgraph solution("SOLUTION", ENGINE_SOLUTION_GRAPH);
+    loadQuiet(paths, fileName);
+    loadQuiet(solution, fileName);
+    
+    int failed = checkOrder(paths, fileName + " at load");
+    failed = failed + checkOptimal(paths, solution, true, fileName + " at load");
+    
+    // random nodes of the frontier are solved on both graphs, in the same order
+    mt19937 generator(seed);
+    for (int step = 1; paths.head->nSolved == false; step++)
+    {
+        vector<AOnode*> frontier = paths.getFrontier();
+        string name = frontier[generator() % frontier.size()]->nName;
+        paths.solveByName(name);
+        solution.solveByName(name);
+        if (paths.head->nSolved == true)
+            break;
+        string what = fileName + " after " + to_string(step) + " solved nodes";
+        failed = failed + checkOptimal(paths, solution, tree, what);
+        if (tree == true)
+            failed = failed + checkOrder(paths, what);
+    }
+    
+    return failed;
+}
+
+int main(int argc, char **argv)
+{
+    int numGraphs = (argc > 1) ? atoi(argv[1]) : 24;
+    int failed = 0;
+    int numChecked = 0;
+    for (int i=0; i< numGraphs; i++)
+    {
+        // trees and graphs with shared nodes, with few distinct costs (many ties)
+        GraphSettings settings;
+        settings.depth = 2 + i % 3;
+        settings.orBranching = 2 + i % 2;
+        settings.andFanout = 2;
+        settings.sharing = (i % 2 == 0) ? 0.0 : 0.4;
+        settings.costs = (i % 4 < 2) ? COST_CONSTANT : COST_UNIFORM;
+        settings.maxCost = 1 + i % 3;
+        settings.seed = i+1;
+        GraphGenerator generator(settings);
+        generator.generate();
+        if (generator.countPaths() > 5000)
+            continue;
+        string fileName = "pathcheck_" + settings.graphName() + ".txt";
+        if (generator.writeDescription(fileName) == false)
+            return 1;
+        
+        failed = failed + checkGraph(fileName, settings.sharing == 0.0, settings.seed);
+        numChecked++;
+        remove(fileName.c_str());
+    }
+    
+    cout<<"[REPORT] " <<numChecked <<" graphs: " <<failed <<" failed checks of the optimal path." <<endl;
+    
+    return (failed == 0) ? 0 : 1;
+}
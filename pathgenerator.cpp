@@ -0,0 +1,288 @@
+//===============================================================================//
+// Name			: pathgenerator.cpp
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Description	: Generation of the paths of an AND-OR graph on a pool of threads
+//===============================================================================//
+
+#include <thread>
+
+#include "pathgenerator.h"
+
+//! constructor of class GeneratedStep
+//! @param[in] parent   previous step along the path (NULL = head node only)
+//! @param[in] node     identifier of the node whose hyperarc has been chosen
+//! @param[in] arc      position of the chosen hyperarc in the node
+GeneratedStep::GeneratedStep(const GeneratedStep* parent, int node, int arc)
+{
+    gParent = parent;
+    gNode = node;
+    gArc = arc;
+    gMerged = -1;
+}
+
+//! constructor of class GeneratedPath
+//! @param[in] lastStep     last hyperarc chosen along the path (NULL = head node only)
+GeneratedPath::GeneratedPath(const GeneratedStep* lastStep)
+{
+    gLastStep = lastStep;
+    gCost = 0;
+    gLength = 0;
+}
+
+//! constructor of class GenerationTask
+//! @param[in] path             path to complete
+//! @param[in] firstUnchecked   position of the first not-checked node
+//! @param[in] cost             cost of the path so far
+GenerationTask::GenerationTask(GeneratedPath* path, int firstUnchecked, int cost)
+{
+    tPath = path;
+    tFirstUnchecked = firstUnchecked;
+    tCost = cost;
+}
+
+//! constructor of class GenerationWorker
+GenerationWorker::GenerationWorker()
+{
+    wVisited = 0;
+}
+
+//! constructor of class PathGenerator
+//! @param[in] graph        compiled form of the graph
+//! @param[in] numThreads   number of threads of the pool
+PathGenerator::PathGenerator(const CompiledGraph* graph, int numThreads)
+{
+    compiled = graph;
+    headNode = -1;
+    for (int i=0; i< numThreads; i++)
+        workers.push_back(new GenerationWorker());
+    pending = 0;
+    queued = 0;
+    sleeping = 0;
+}
+
+//! add a task to the tasks of a worker
+//! @param[in] worker   index of the worker
+//! @param[in] task     task to add
+void PathGenerator::push(int worker, unique_ptr<GenerationTask> task)
+{
+    pending++;
+    {
+        lock_guard<mutex> guard(workers[worker]->wLock);
+        workers[worker]->wTasks.push_back(move(task));
+    }
+    queued++;
+    
+    // wake up a waiting worker (if any) to steal the task
+    if (sleeping > 0)
+    {
+        lock_guard<mutex> guard(idleLock);
+        idle.notify_one();
+    }
+}
+
+//! take a task of a worker, or steal one from another worker
+//! @param[in] worker   index of the worker
+//! @return             task to run (NULL = no task available)
+unique_ptr<GenerationTask> PathGenerator::take(int worker)
+{
+    // the worker takes its last task (the paths are completed depth-first,
+    // which keeps few tasks waiting), the others steal the first one
+    for (int i=0; i< (int)workers.size(); i++)
+    {
+        GenerationWorker* victim = workers[(worker + i) % workers.size()];
+        lock_guard<mutex> guard(victim->wLock);
+        if (victim->wTasks.empty() == true)
+            continue;
+        
+        unique_ptr<GenerationTask> task;
+        if (i == 0)
+        {
+            task = move(victim->wTasks.back());
+            victim->wTasks.pop_back();
+        }
+        else
+        {
+            task = move(victim->wTasks.front());
+            victim->wTasks.pop_front();
+        }
+        queued--;
+        return task;
+    }
+    
+    return unique_ptr<GenerationTask>();
+}
+
+//! compute the nodes of a path from its steps
+//! N.B. same order as PathStore::expand(): the head node followed by the
+//! child nodes of each hyperarc
+//! @param[in] worker       index of the worker (the nodes are stored in wNodes)
+//! @param[in] lastStep     last hyperarc chosen along the path (NULL = head node only)
+void PathGenerator::expand(int worker, const GeneratedStep* lastStep)
+{
+    vector<int> &nodes = workers[worker]->wNodes;
+    vector<const GeneratedStep*> &chain = workers[worker]->wChain;
+    chain.clear();
+    for (const GeneratedStep* s = lastStep; s != NULL; s = s->gParent)
+        chain.push_back(s);
+    
+    nodes.clear();
+    nodes.push_back(headNode);
+    for (int i = (int)chain.size()-1; i > -1; i--)
+    {
+        int arc = compiled->arcOffset[chain[i]->gNode] + chain[i]->gArc;
+        nodes.insert(nodes.end(), compiled->childNode.begin() + compiled->childOffset[arc],
+            compiled->childNode.begin() + compiled->childOffset[arc+1]);
+    }
+}
+
+//! complete a path, creating a task for each of its copies
+//! N.B. same steps as AOgraph::generatePaths(), for a single path
+//! @param[in] worker   index of the worker
+//! @param[in] task     task to run
+void PathGenerator::run(int worker, const GenerationTask &task)
+{
+    GeneratedPath* path = task.tPath;
+    deque<GeneratedStep> &workerSteps = workers[worker]->wSteps;
+    expand(worker, path->gLastStep);
+    vector<int> &pathNodes = workers[worker]->wNodes;
+    int cost = task.tCost;
+    
+    for (int currentNodeIndex = task.tFirstUnchecked;
+         currentNodeIndex < (int)pathNodes.size(); currentNodeIndex++)
+    {
+        int currentNode = pathNodes[currentNodeIndex];
+        int firstArc = compiled->arcOffset[currentNode];
+        int numNodeArcs = compiled->arcOffset[currentNode+1] - firstArc;
+        
+        // a terminal node only adds its cost
+        if (numNodeArcs == 0)
+        {
+            cost = cost + compiled->nodeCost[currentNode];
+            continue;
+        }
+        
+        // each other hyperarc creates a copy of the path (sharing its steps),
+        // completed by a new task
+        for (int i=0; i< numNodeArcs-1; i++)
+        {
+            int arc = firstArc+i+1;
+            workerSteps.push_back(GeneratedStep(path->gLastStep, currentNode, i+1));
+            path->gSteps.push_back(&workerSteps.back());
+            workers[worker]->wPaths.push_back(GeneratedPath(&workerSteps.back()));
+            GeneratedPath* copy = &workers[worker]->wPaths.back();
+            path->gCopies.push_back(copy);
+            
+            push(worker, unique_ptr<GenerationTask>(new GenerationTask(copy, currentNodeIndex+1,
+                cost + compiled->nodeCost[currentNode] + compiled->arcCost[arc])));
+        }
+        
+        // the path itself follows the first hyperarc
+        workerSteps.push_back(GeneratedStep(path->gLastStep, currentNode, 0));
+        path->gSteps.push_back(&workerSteps.back());
+        path->gLastStep = &workerSteps.back();
+        cost = cost + compiled->nodeCost[currentNode] + compiled->arcCost[firstArc];
+        pathNodes.insert(pathNodes.end(), compiled->childNode.begin() + compiled->childOffset[firstArc],
+            compiled->childNode.begin() + compiled->childOffset[firstArc+1]);
+    }
+    
+    path->gCost = cost;
+    path->gLength = pathNodes.size();
+    ENDOR_COUNT(workers[worker]->wVisited, pathNodes.size() - task.tFirstUnchecked);
+}
+
+//! run the tasks until all paths are complete
+//! N.B. a worker without tasks waits until a task is added or all paths are complete
+//! @param[in] worker   index of the worker
+void PathGenerator::work(int worker)
+{
+    while (true)
+    {
+        unique_ptr<GenerationTask> task = take(worker);
+        if (task)
+        {
+            run(worker, *task);
+            task.reset();
+            if (--pending == 0)
+            {
+                lock_guard<mutex> guard(idleLock);
+                idle.notify_all();
+            }
+            continue;
+        }
+        
+        unique_lock<mutex> guard(idleLock);
+        sleeping++;
+        while ((queued == 0) && (pending > 0))
+            idle.wait(guard);
+        sleeping--;
+        if (pending == 0)
+            return;
+    }
+}
+
+//! merge the paths of the workers in the set of paths
+//! N.B. AOgraph::generatePaths() adds the copies of a path after all paths
+//! existing when the path is completed: the paths are indexed in breadth-first
+//! order of the copies, and the steps of each path follow those of the previous path
+//! @param[in] first        path with the head node
+//! @param[out] paths       set of paths
+void PathGenerator::merge(GeneratedPath* first, PathStore &paths)
+{
+    vector<GeneratedPath*> order(1, first);
+    for (int i=0; i< (int)order.size(); i++)
+        order.insert(order.end(), order[i]->gCopies.begin(), order[i]->gCopies.end());
+    
+    int numSteps = 0;
+    for (int i=0; i< (int)order.size(); i++)
+        numSteps = numSteps + order[i]->gSteps.size();
+    paths.steps.reserve(numSteps);
+    paths.entries.reserve(order.size());
+    
+    // the steps shared by a path are created by a path preceding it: they are already merged
+    for (int i=0; i< (int)order.size(); i++)
+    {
+        GeneratedPath* path = order[i];
+        for (int j=0; j< (int)path->gSteps.size(); j++)
+        {
+            GeneratedStep* step = path->gSteps[j];
+            int parent = (step->gParent == NULL) ? -1 : step->gParent->gMerged;
+            step->gMerged = paths.addStep(parent, step->gNode, step->gArc);
+        }
+        int lastStep = (path->gLastStep == NULL) ? -1 : path->gLastStep->gMerged;
+        int index = paths.addPath(path->gCost, lastStep, path->gLength);
+        paths.entries[index].eComplete = true;
+    }
+}
+
+//! generate all paths from the head node
+//! @param[in] head     identifier of the head node
+//! @param[out] paths   set of paths (empty)
+void PathGenerator::generate(int head, PathStore &paths)
+{
+    headNode = head;
+    workers[0]->wPaths.push_back(GeneratedPath(NULL));
+    GeneratedPath* first = &workers[0]->wPaths.back();
+    push(0, unique_ptr<GenerationTask>(new GenerationTask(first, 0, 0)));
+    
+    // the calling thread is the first worker of the pool
+    vector<thread> threads;
+    for (int i=1; i< (int)workers.size(); i++)
+        threads.push_back(thread(&PathGenerator::work, this, i));
+    work(0);
+    for (int i=0; i< (int)threads.size(); i++)
+        threads[i].join();
+    
+    merge(first, paths);
+}
+
+//! number of nodes visited by all workers
+//! @return     number of nodes visited while completing the paths
+long long PathGenerator::visitedNodes() const
+{
+    long long visited = 0;
+    for (int i=0; i< (int)workers.size(); i++)
+        visited = visited + workers[i]->wVisited;
+    
+    return visited;
+}
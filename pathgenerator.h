@@ -0,0 +1,132 @@
+//===============================================================================//
+// Name			: pathgenerator.h
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Description	: Generation of the paths of an AND-OR graph on a pool of threads
+//===============================================================================//
+
+#ifndef PATHGENERATOR_H
+#define PATHGENERATOR_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+#include "graphstats.h"
+#include "pathstore.h"
+
+using namespace std;
+
+//! class "GeneratedStep" for a hyperarc chosen along a path completed by a worker
+//! N.B. as in PathStore, the paths copied from a path share its steps: a step
+//! never changes once created, and is read by the workers completing the copies
+class GeneratedStep
+{
+    public:
+        const GeneratedStep* gParent;   //!< previous step along the path (NULL = head node only)
+        int gNode;                  //!< identifier of the node whose hyperarc has been chosen
+        int gArc;                   //!< position of the chosen hyperarc in the node
+        int gMerged;                //!< index of the step in the merged steps
+        
+        //! constructor
+        GeneratedStep(const GeneratedStep* parent, int node, int arc);
+};
+
+//! class "GeneratedPath" for a path completed by a worker (before the merge)
+class GeneratedPath
+{
+    public:
+        const GeneratedStep* gLastStep; //!< last hyperarc chosen along the path (NULL = head node only)
+        vector<GeneratedStep*> gSteps;  //!< steps created while completing the path, in creation order
+        int gCost;                  //!< overall cost of all the nodes in the path
+        int gLength;                //!< number of nodes in the path
+        vector<GeneratedPath*> gCopies; //!< copies of the path, in creation order
+        
+        //! constructor
+        GeneratedPath(const GeneratedStep* lastStep);
+};
+
+//! class "GenerationTask" for a path to complete
+//! N.B. the nodes of the path so far are computed from its steps
+class GenerationTask
+{
+    public:
+        GeneratedPath* tPath;       //!< path to complete
+        int tFirstUnchecked;        //!< position of the first not-checked node
+        int tCost;                  //!< cost of the path so far
+        
+        //! constructor
+        GenerationTask(GeneratedPath* path, int firstUnchecked, int cost);
+};
+
+//! class "GenerationWorker" for a thread of the pool, with its own tasks and paths
+class GenerationWorker
+{
+    public:
+        mutex wLock;                    //!< lock of the tasks
+        deque< unique_ptr<GenerationTask> > wTasks; //!< tasks to run (the worker takes the last one, the others steal the first one)
+        deque<GeneratedPath> wPaths;    //!< paths created by the worker (stable storage)
+        deque<GeneratedStep> wSteps;    //!< steps created by the worker (stable storage)
+        vector<int> wNodes;             //!< nodes of the path being completed
+        vector<const GeneratedStep*> wChain; //!< steps of the path being completed (to compute its nodes)
+        long long wVisited;             //!< number of nodes visited by the worker (if ENDOR_STATS is 1)
+        
+        //! constructor
+        GenerationWorker();
+};
+
+//! class "PathGenerator" for the generation of the paths on a pool of threads
+//! N.B. the paths are completed in any order, then merged in the order of
+//! AOgraph::generatePaths(): the path indices and the steps are the same
+class PathGenerator
+{
+    protected:
+        const CompiledGraph* compiled;      //!< compiled form of the graph
+        int headNode;                       //!< identifier of the head node
+        vector<GenerationWorker*> workers;  //!< workers of the pool
+        atomic<int> pending;                //!< number of tasks not completed yet
+        atomic<int> queued;                 //!< number of tasks waiting to be taken
+        atomic<int> sleeping;               //!< number of workers waiting for a task
+        mutex idleLock;                     //!< lock of the workers waiting for a task
+        condition_variable idle;            //!< signal of a new task (or of the end of the generation)
+        
+        //! add a task to the tasks of a worker
+        void push(int worker, unique_ptr<GenerationTask> task);
+        
+        //! take a task of a worker, or steal one from another worker
+        unique_ptr<GenerationTask> take(int worker);
+        
+        //! compute the nodes of a path from its steps
+        void expand(int worker, const GeneratedStep* lastStep);
+        
+        //! complete a path, creating a task for each of its copies
+        void run(int worker, const GenerationTask &task);
+        
+        //! run the tasks until all paths are complete
+        void work(int worker);
+        
+        //! merge the paths of the workers in the set of paths
+        void merge(GeneratedPath* first, PathStore &paths);
+    
+    public:
+        //! constructor
+        PathGenerator(const CompiledGraph* graph, int numThreads);
+        
+        //! generate all paths from the head node
+        void generate(int head, PathStore &paths);
+        
+        //! number of nodes visited by all workers
+        long long visitedNodes() const;
+        
+        //! destructor
+		~PathGenerator()
+		{
+			//DEBUG:cout<<endl <<"Destroying PathGenerator object" <<endl;
+            for (int i=0; i< (int)workers.size(); i++)
+                delete workers[i];
+		}
+};
+
+#endif
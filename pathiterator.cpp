@@ -0,0 +1,244 @@
+//===============================================================================//
+// Name			: pathiterator.cpp
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Description	: Lazy iterator on the paths of an AND-OR graph, in increasing cost order
+//===============================================================================//
+
+#include "pathiterator.h"
+
+//! constructor of class Derivation
+//! @param[in] arc          position of the hyperarc in the node (-1 = terminal node)
+//! @param[in] ranks        rank of the solution used for each child node
+//! @param[in] cost         cost of the solution
+//! @param[in] deviations   number of non-first hyperarcs in the solution
+Derivation::Derivation(int arc, vector<int> ranks, int cost, int deviations)
+{
+    dArc = arc;
+    dRanks = ranks;
+    dCost = cost;
+    dDeviations = deviations;
+}
+
+//! constructor of class DerivationOrder
+//! @param[in] pathIterator     iterator holding the derivations of the child nodes
+//! @param[in] index            index of the node
+DerivationOrder::DerivationOrder(const PathIterator* pathIterator, int index)
+{
+    iterator = pathIterator;
+    node = index;
+}
+
+//! order of the derivations (true = the first derivation comes after the second one)
+//! @param[in] derivation   derivation of the node
+//! @param[in] other        derivation of the node to compare with
+//! @return                 true if the derivation has to be returned after the other one
+bool DerivationOrder::operator()(const Derivation &derivation, const Derivation &other) const
+{
+    return iterator->comesAfter(node, derivation, other);
+}
+
+//! constructor of class PathIterator
+//! @param[in] graph    graph to navigate
+PathIterator::PathIterator(AOgraph &graph)
+{
+    aograph = &graph;
+    rank = 0;
+    
+    int numNodes = (int)aograph->graph.size();
+    started.assign(numNodes, false);
+    found.resize(numNodes);
+    expanded.assign(numNodes, 0);
+    for (int i=0; i< numNodes; i++)
+        candidates.push_back(priority_queue<Derivation, vector<Derivation>, DerivationOrder>(DerivationOrder(this, i)));
+    generated.resize(numNodes);
+}
+
+//! order of the derivations of a node (true = the first derivation comes after the second one)
+//! N.B. same order as the indices of generatePaths() (see AOgraph::arcComesFirst()):
+//! the paths are returned in the order findOptimalPath() would choose them
+//! @param[in] node         index of the node
+//! @param[in] derivation   derivation of the node
+//! @param[in] other        derivation of the node to compare with
+//! @return                 true if the derivation has to be returned after the other one
+bool PathIterator::comesAfter(int node, const Derivation &derivation, const Derivation &other) const
+{
+    // 1. cheaper first
+    // 2. with the same cost, fewer non-first hyperarcs first
+    if (derivation.dCost != other.dCost)
+        return derivation.dCost > other.dCost;
+    if (derivation.dDeviations != other.dDeviations)
+        return derivation.dDeviations > other.dDeviations;
+    
+    // 3. then, the hyperarcs of the first node where the derivations differ
+    //    (moving along both from the node, in the order of generatePaths()):
+    //    the child nodes with the same derivation are skipped, they never differ
+    const CompiledGraph &compiled = aograph->compiled;
+    vector<int> nodes(1, node);
+    vector<const Derivation*> first(1, &derivation);
+    vector<const Derivation*> second(1, &other);
+    for (int i=0; i< (int)nodes.size(); i++)
+    {
+        if (first[i]->dArc != second[i]->dArc)
+            return AOgraph::arcComesFirst(second[i]->dArc, first[i]->dArc);
+        
+        int arc = compiled.arcOffset[nodes[i]] + first[i]->dArc;
+        for (int j=0; j< (int)first[i]->dRanks.size(); j++)
+        {
+            if (first[i]->dRanks[j] == second[i]->dRanks[j])
+                continue;
+            int child = compiled.childNode[compiled.childOffset[arc] + j];
+            nodes.push_back(child);
+            first.push_back(&found[child][first[i]->dRanks[j]]);
+            second.push_back(&found[child][second[i]->dRanks[j]]);
+        }
+    }
+    
+    return false;
+}
+
+//! create a derivation of a node, computing its cost
+//! @param[in] node     index of the node
+//! @param[in] arc      position of the hyperarc in the node (-1 = terminal node)
+//! @param[in] ranks    rank of the solution used for each child node
+//! @return             derivation with its cost
+Derivation PathIterator::makeDerivation(int node, int arc, vector<int> ranks)
+{
+    const CompiledGraph &compiled = aograph->compiled;
+    
+    // terminal node: the only derivation costs node.nCost
+    if (arc == -1)
+        return Derivation(arc, ranks, compiled.nodeCost[node], 0);
+    
+    // same cost as the solution graph engine: node + hyperarc - benefit + child nodes
+    int compiledArc = compiled.arcOffset[node] + arc;
+    int cost = compiled.nodeCost[node] + compiled.arcCost[compiledArc] - aograph->arcBenefit[compiledArc];
+    int deviations = (arc == 0) ? 0 : 1;
+    for (int i=0; i< (int)ranks.size(); i++)
+    {
+        int child = compiled.childNode[compiled.childOffset[compiledArc] + i];
+        cost = cost + found[child][ranks[i]].dCost;
+        deviations = deviations + found[child][ranks[i]].dDeviations;
+    }
+    
+    return Derivation(arc, ranks, cost, deviations);
+}
+
+//! add a derivation to the candidates of a node (if not generated yet)
+//! @param[in] node     index of the node
+//! @param[in] arc      position of the hyperarc in the node
+//! @param[in] ranks    rank of the solution used for each child node
+void PathIterator::addCandidate(int node, int arc, vector<int> ranks)
+{
+    // the same derivation can be reached from several predecessors
+    if (generated[node].insert(make_pair(arc, ranks)).second == false)
+        return;
+    
+    candidates[node].push(makeDerivation(node, arc, ranks));
+}
+
+//! find the k-th best derivation of a node
+//! @param[in] node     index of the node
+//! @param[in] k        rank of the derivation (0 = best)
+//! @return             true if the node has at least k+1 derivations
+bool PathIterator::findKthBest(int node, int k)
+{
+    const CompiledGraph &compiled = aograph->compiled;
+    int firstArc = compiled.arcOffset[node];
+    
+    // first request: the candidates are the best derivations through each hyperarc
+    if (started[node] == false)
+    {
+        started[node] = true;
+        if (compiled.arcOffset[node+1] == firstArc)
+            addCandidate(node, -1, vector<int>());
+        for (int i=0; i< compiled.arcOffset[node+1] - firstArc; i++)
+        {
+            int arc = firstArc + i;
+            vector<int> ranks(compiled.childOffset[arc+1] - compiled.childOffset[arc], 0);
+            for (int j=0; j< (int)ranks.size(); j++)
+                findKthBest(compiled.childNode[compiled.childOffset[arc] + j], 0);
+            addCandidate(node, i, ranks);
+        }
+    }
+    
+    while ((int)found[node].size() <= k)
+    {
+        // the successors of the last derivation become candidates only now:
+        // derivations are computed only when the caller asks for them
+        if (expanded[node] < (int)found[node].size())
+        {
+            Derivation last = found[node][expanded[node]];
+            expanded[node] = expanded[node] + 1;
+            for (int i=0; i< (int)last.dRanks.size(); i++)
+            {
+                int child = compiled.childNode[compiled.childOffset[firstArc + last.dArc] + i];
+                vector<int> ranks = last.dRanks;
+                ranks[i] = ranks[i] + 1;
+                if (findKthBest(child, ranks[i]) == true)
+                    addCandidate(node, last.dArc, ranks);
+            }
+        }
+        
+        if (candidates[node].empty() == true)
+            return false;
+        found[node].push_back(candidates[node].top());
+        candidates[node].pop();
+    }
+    
+    return true;
+}
+
+//! build the path corresponding to the k-th best derivation of the head node
+//! @param[in] k        rank of the derivation of the head node
+//! @param[out] path    path to build
+void PathIterator::buildPath(int k, Path &path)
+{
+    path = Path(0, k);
+    
+    // expand the nodes in the same order used by generatePaths():
+    // each node of the path comes with the rank of its derivation
+    const CompiledGraph &compiled = aograph->compiled;
+    vector<int> pathRanks;
+    path.addNode(aograph->head);
+    pathRanks.push_back(k);
+    for (int i=0; i< (int)path.pathNodes.size(); i++)
+    {
+        int current = path.pathNodes[i]->nId;
+        Derivation &chosen = found[current][pathRanks[i]];
+        if (chosen.dArc == -1)
+            continue;
+        
+        int arc = compiled.arcOffset[current] + chosen.dArc;
+        path.pathArcs.push_back(compiled.arcIndex[arc]);
+        for (int j=0; j< (int)chosen.dRanks.size(); j++)
+        {
+            path.addNode(compiled.node[compiled.childNode[compiled.childOffset[arc] + j]]);
+            pathRanks.push_back(chosen.dRanks[j]);
+        }
+    }
+    path.pCost = found[aograph->head->nId][k].dCost;
+    path.pComplete = true;
+    aograph->checkSolvedNodes(path);
+}
+
+//! compute the next path
+//! @param[out] path    next path, in increasing cost order
+//! @return             false if there are no more paths
+bool PathIterator::next(Path &path)
+{
+    // raise an error if there is no graph to navigate
+    if (aograph->head == NULL)
+    {
+        ENDOR_MESSAGE("[WARNING] There is no graph to navigate (head == NULL).");
+        return false;
+    }
+    
+    if (findKthBest(aograph->head->nId, rank) == false)
+        return false;
+    
+    buildPath(rank, path);
+    rank = rank + 1;
+    
+    return true;
+}
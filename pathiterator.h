@@ -0,0 +1,91 @@
+//===============================================================================//
+// Name			: pathiterator.h
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Description	: Lazy iterator on the paths of an AND-OR graph, in increasing cost order
+//===============================================================================//
+
+#ifndef PATHITERATOR_H
+#define PATHITERATOR_H
+
+#include <queue>
+#include <set>
+
+#include "aograph.h"
+
+using namespace std;
+
+//! class "Derivation" for one way of solving a node (hyperarc + ranked solutions of the child nodes)
+class Derivation
+{
+    public:
+        int dArc;               //!< position of the hyperarc in the node (-1 = terminal node)
+        vector<int> dRanks;     //!< rank of the solution used for each child node
+        int dCost;              //!< cost of the solution
+        int dDeviations;        //!< number of non-first hyperarcs in the solution
+        
+        //! constructor
+        Derivation(int arc, vector<int> ranks, int cost, int deviations);
+};
+
+// empty declaration (required by DerivationOrder)
+class PathIterator;
+
+//! class "DerivationOrder" for the order of the derivations of a node (see PathIterator::comesAfter())
+class DerivationOrder
+{
+    public:
+        const PathIterator* iterator;   //!< iterator holding the derivations of the child nodes
+        int node;                       //!< index of the node
+        
+        //! constructor
+        DerivationOrder(const PathIterator* pathIterator, int index);
+        
+        //! order of the derivations (true = the first derivation comes after the second one)
+        bool operator()(const Derivation &derivation, const Derivation &other) const;
+};
+
+//! class "PathIterator" returning the paths of the graph one at a time, in increasing cost order
+//! N.B. the iterator refers to the state of the graph at its creation:
+//! create a new iterator after solving a node
+class PathIterator
+{
+    protected:
+        AOgraph* aograph;       //!< graph to navigate
+        int rank;               //!< rank of the next path to return
+        vector<bool> started;   //!< started: the candidates of the node have been created
+        vector< vector<Derivation> > found;     //!< derivations of each node, in increasing cost order
+        vector<int> expanded;   //!< number of derivations of each node whose successors are candidates
+        vector< priority_queue<Derivation, vector<Derivation>, DerivationOrder> > candidates;  //!< next derivations of each node
+        vector< set< pair<int, vector<int> > > > generated;  //!< derivations already generated for each node
+        
+        //! create a derivation of a node, computing its cost
+        Derivation makeDerivation(int node, int arc, vector<int> ranks);
+        
+        //! add a derivation to the candidates of a node (if not generated yet)
+        void addCandidate(int node, int arc, vector<int> ranks);
+        
+        //! find the k-th best derivation of a node
+        bool findKthBest(int node, int k);
+        
+        //! build the path corresponding to the k-th best derivation of the head node
+        void buildPath(int k, Path &path);
+    
+    public:
+        //! constructor
+        PathIterator(AOgraph &graph);
+        
+        //! order of the derivations of a node (true = the first derivation comes after the second one)
+        bool comesAfter(int node, const Derivation &derivation, const Derivation &other) const;
+        
+        //! compute the next path
+        bool next(Path &path);
+        
+        //! destructor
+		~PathIterator()
+		{
+			//DEBUG:cout<<endl <<"Destroying PathIterator object" <<endl;
+		}
+};
+
+#endif
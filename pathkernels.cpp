@@ -0,0 +1,98 @@
+//===============================================================================//
+// Name			: pathkernels.cpp
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Description	: Vectorized kernels over the path costs (AVX2, with scalar fallback)
+//===============================================================================//
+
+#include "pathkernels.h"
+
+#if ENDOR_AVX2
+#include <immintrin.h>
+#endif
+
+//! find the first position of the minimum value (scalar version)
+//! @param[in] values   values to scan
+//! @param[in] count    number of values
+//! @return             first position of the minimum value (-1 = no values)
+int findMinimumScalar(const int* values, int count)
+{
+    if (count <= 0)
+        return -1;
+    
+    int best = 0;
+    for (int i=1; i< count; i++)
+        if (values[i] < values[best])
+            best = i;
+    
+    return best;
+}
+
+#if ENDOR_AVX2
+//! find the first position of the minimum value (AVX2 version, the CPU must support AVX2)
+//! N.B. the minimum is found 8 values at a time, then its first position
+//! @param[in] values   values to scan
+//! @param[in] count    number of values
+//! @return             first position of the minimum value (-1 = no values)
+__attribute__((target("avx2")))
+int findMinimumAVX2(const int* values, int count)
+{
+    if (count < 8)
+        return findMinimumScalar(values, count);
+    
+    // 1. minimum of each lane, then of the 8 lanes
+    __m256i lanes = _mm256_loadu_si256((const __m256i*)values);
+    int i = 8;
+    for (; i+8 <= count; i = i+8)
+        lanes = _mm256_min_epi32(lanes, _mm256_loadu_si256((const __m256i*)(values+i)));
+    int lane[8];
+    _mm256_storeu_si256((__m256i*)lane, lanes);
+    int minimum = lane[0];
+    for (int j=1; j< 8; j++)
+        if (lane[j] < minimum)
+            minimum = lane[j];
+    for (; i< count; i++)
+        if (values[i] < minimum)
+            minimum = values[i];
+    
+    // 2. first position of the minimum
+    __m256i target = _mm256_set1_epi32(minimum);
+    for (i=0; i+8 <= count; i = i+8)
+    {
+        __m256i equal = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(values+i)), target);
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(equal));
+        if (mask != 0)
+            return i + __builtin_ctz(mask);
+    }
+    for (; i< count; i++)
+        if (values[i] == minimum)
+            return i;
+    
+    return -1;
+}
+#endif
+
+//! determine whether the vectorized kernels are used
+//! @return     true if the kernels are compiled and the CPU supports AVX2
+bool vectorKernels()
+{
+#if ENDOR_AVX2
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+//! find the first position of the minimum value (AVX2 if available)
+//! @param[in] values   values to scan
+//! @param[in] count    number of values
+//! @return             first position of the minimum value (-1 = no values)
+int findMinimum(const int* values, int count)
+{
+#if ENDOR_AVX2
+    if (vectorKernels() == true)
+        return findMinimumAVX2(values, count);
+#endif
+    return findMinimumScalar(values, count);
+}
@@ -0,0 +1,36 @@
+//===============================================================================//
+// Name			: pathkernels.h
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Description	: Vectorized kernels over the path costs (AVX2, with scalar fallback)
+//===============================================================================//
+
+#ifndef PATHKERNELS_H
+#define PATHKERNELS_H
+
+//! AVX2 kernels are compiled only if ENDOR_SIMD is 1 (and used only if the CPU supports AVX2)
+#ifndef ENDOR_SIMD
+#define ENDOR_SIMD 1
+#endif
+
+#if ENDOR_SIMD && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ENDOR_AVX2 1
+#else
+#define ENDOR_AVX2 0
+#endif
+
+//! find the first position of the minimum value (AVX2 if available)
+int findMinimum(const int* values, int count);
+
+//! find the first position of the minimum value (scalar version)
+int findMinimumScalar(const int* values, int count);
+
+#if ENDOR_AVX2
+//! find the first position of the minimum value (AVX2 version, the CPU must support AVX2)
+int findMinimumAVX2(const int* values, int count);
+#endif
+
+//! determine whether the vectorized kernels are used
+bool vectorKernels();
+
+#endif
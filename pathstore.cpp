@@ -0,0 +1,515 @@
+//===============================================================================//
+// Name			: pathstore.cpp
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Description	: Paths navigating an AND-OR graph, stored sharing their common prefixes
+//===============================================================================//
+
+#include "pathstore.h"
+
+//! constructor of class Path
+//! @param[in] cost 	initial cost of the path
+//! @param[in] index 	unique index of the path
+Path::Path(int cost, int index)
+{
+    pIndex = index;
+    pCost = cost;
+    pComplete = false;
+}
+
+//! copy constructor of class Path
+//! @param[in] &toBeCopied  path to be copied
+//! @param[in] index        unique index of the path
+Path::Path(const Path &toBeCopied, int index)
+{
+    pIndex = index;
+    pCost = toBeCopied.pCost;
+    pComplete = false;
+    pathNodes = toBeCopied.pathNodes;
+    pathArcs = toBeCopied.pathArcs;
+    checkedNodes = toBeCopied.checkedNodes;
+}
+
+//! display path information
+void Path::printPathInfo()
+{
+    cout<<"Info of path: " <<pIndex <<endl;
+    //DEBUG: cout<<"Is complete? " <<boolalpha <<pComplete <<endl;
+    cout<<"Total cost: " <<pCost <<endl;
+    cout<<"Hyperarcs in path: ";
+    for (int i=0; i< (int)pathArcs.size(); i++)
+        cout<<pathArcs[i] <<" ";
+    cout<<endl <<"Nodes in path:" <<endl;
+    for (int i=0; i< (int)pathNodes.size(); i++)
+    {
+        cout<<pathNodes[i]->nName <<" ";
+        //DEBUG: cout<<"checked? " <<boolalpha <<checkedNodes[i];
+        if (checkedNodes[i] == true)
+            cout<<"- done";
+        cout<<endl;
+    }
+    cout<<endl;
+}
+
+//! add a node in the path
+//! @param[in] node     node to add to the path
+void Path::addNode(AOnode* node)
+{
+    // update the nodes in the path
+    pathNodes.push_back(node);
+    checkedNodes.push_back(false);
+    
+    // N.B. the cost of the path is updated when the node is checked
+}
+
+//! update the path information (when a node is solved)
+//! @param[in] idNode       identifier of the node
+//! @param[in] cost         cost to subtract from the path cost
+void Path::updatePath(int idNode, int cost)
+{
+   // check whether the node is in the path
+    for(int i=0; i < (int)pathNodes.size(); i++)
+    {
+        // keep track of solved nodes
+        if (pathNodes[i]->nId == idNode)
+            checkedNodes[i] = true;
+    }
+    // update the cost of the path        
+    pCost = pCost - cost;
+}
+
+//! find the feasible node to suggest
+//! @return node to suggest
+AOnode* Path::suggestNode()
+{
+    AOnode* selection = NULL;
+    
+    // iterate on the nodes in the path, from the last to the first one
+    for (int i = (int)pathNodes.size()-1; i > -1; i--)
+    {
+        // rationale for the suggestion:
+        // 1. move along the path from the leaves to the head
+        // 2. choose the first feasible & not-solved node
+        if (checkedNodes[i] == false)
+        {
+            if (pathNodes[i]->nFeasible == true)
+            {
+                selection = pathNodes[i];
+                break;
+            }
+        }
+    }
+    
+    // raise an error if the suggested node is NULL
+    if (selection == NULL)
+        ENDOR_MESSAGE("[ERROR] No suggestion possible.");
+    
+    return selection;
+}
+
+//! constructor of class PathStep
+//! @param[in] parent   previous step along the path (-1 = head node only)
+//! @param[in] node     identifier of the node whose hyperarc has been chosen
+//! @param[in] arc      position of the chosen hyperarc in the node
+PathStep::PathStep(int parent, int node, int arc)
+{
+    sParent = parent;
+    sArc = arc;
+    sNode = node;
+}
+
+//! constructor of class PathEntry
+//! @param[in] lastStep     last hyperarc chosen along the path
+//! @param[in] length       number of nodes in the path
+PathEntry::PathEntry(int lastStep, int length)
+{
+    eLastStep = lastStep;
+    eLength = length;
+    eChecked = -1;
+    eComplete = false;
+}
+
+//! constructor of class PathCheck
+//! @param[in] previous     solved node checked before in the same path (-1 = none)
+//! @param[in] node         solved node
+PathCheck::PathCheck(int previous, AOnode* node)
+{
+    cPrevious = previous;
+    cNode = node;
+}
+
+//! constructor of class PathOccurrence
+//! @param[in] path     index of the path
+//! @param[in] count    number of occurrences in the path
+PathOccurrence::PathOccurrence(int path, int count)
+{
+    oPath = path;
+    oCount = count;
+}
+
+//! constructor of class PathStore
+PathStore::PathStore()
+{
+    head = NULL;
+    compiled = NULL;
+    rowWords = 0;
+    cheapestPath = -1;
+    treeLeaves = 0;
+}
+
+//! remove all paths
+void PathStore::clear()
+{
+    steps.clear();
+    entries.clear();
+    costs.clear();
+    checks.clear();
+    nodePaths.clear();
+    arcPaths.clear();
+    rowWords = 0;
+    arcRows.clear();
+    resetCheapest();
+}
+
+//! number of paths
+//! @return number of paths in the store
+int PathStore::size() const
+{
+    return (int)entries.size();
+}
+
+//! add a path
+//! @param[in] cost         initial cost of the path
+//! @param[in] lastStep     last hyperarc chosen along the path (-1 = head node only)
+//! @param[in] length       number of nodes in the path
+//! @return                 index of the path
+int PathStore::addPath(int cost, int lastStep, int length)
+{
+    entries.push_back(PathEntry(lastStep, length));
+    costs.push_back(cost);
+    resetCheapest();
+    return (int)entries.size()-1;
+}
+
+//! add a hyperarc chosen after a given step
+//! @param[in] parent   previous step along the path (-1 = head node only)
+//! @param[in] node     identifier of the node whose hyperarc has been chosen
+//! @param[in] arc      position of the chosen hyperarc in the node
+//! @return             index of the step
+int PathStore::addStep(int parent, int node, int arc)
+{
+    steps.push_back(PathStep(parent, node, arc));
+    return (int)steps.size()-1;
+}
+
+//! compute the nodes and hyperarcs in a path
+//! @param[in] index    index of the path
+//! @param[out] nodes   identifiers of the nodes in the path
+//! @param[out] arcs    indices of the hyperarcs in the path
+void PathStore::expand(int index, vector<int> &nodes, vector<int> &arcs) const
+{
+    nodes.clear();
+    arcs.clear();
+    if ((head == NULL) || (compiled == NULL))
+        return;
+    
+    // collect the steps of the path, from the last to the first one
+    vector<int> chain;
+    for (int s = entries[index].eLastStep; s != -1; s = steps[s].sParent)
+        chain.push_back(s);
+    
+    // the nodes are the head node followed by the child nodes of each hyperarc
+    nodes.reserve(entries[index].eLength);
+    nodes.push_back(head->nId);
+    for (int i = (int)chain.size()-1; i > -1; i--)
+    {
+        int arc = compiled->arcOffset[steps[chain[i]].sNode] + steps[chain[i]].sArc;
+        arcs.push_back(compiled->arcIndex[arc]);
+        nodes.insert(nodes.end(), compiled->childNode.begin() + compiled->childOffset[arc],
+            compiled->childNode.begin() + compiled->childOffset[arc+1]);
+    }
+}
+
+//! build a copy of a path with all its information
+//! @param[in] index    index of the path
+//! @return             path with its nodes, hyperarcs and checked nodes
+Path PathStore::operator[](int index) const
+{
+    Path path(costs[index], index);
+    path.pComplete = entries[index].eComplete;
+    vector<int> nodes;
+    expand(index, nodes, path.pathArcs);
+    path.pathNodes.resize(nodes.size());
+    for (int i=0; i< (int)nodes.size(); i++)
+        path.pathNodes[i] = compiled->node[nodes[i]];
+    
+    path.checkedNodes.assign(path.pathNodes.size(), false);
+    if (entries[index].eChecked != -1)
+        for (int i=0; i< (int)path.pathNodes.size(); i++)
+            path.checkedNodes[i] = isChecked(index, path.pathNodes[i]);
+    
+    return path;
+}
+
+//! determine whether a solved node is checked in a path
+//! @param[in] index    index of the path
+//! @param[in] node     node to look for
+//! @return             true if the node is checked in the path
+bool PathStore::isChecked(int index, AOnode* node) const
+{
+    for (int c = entries[index].eChecked; c != -1; c = checks[c].cPrevious)
+        if (checks[c].cNode == node)
+            return true;
+    
+    return false;
+}
+
+//! index the paths including each node and hyperarc
+//! @param[in] numNodes     number of nodes in the graph
+//! @param[in] numArcs      number of hyperarcs in the graph
+void PathStore::buildIndex(int numNodes, int numArcs)
+{
+    nodePaths.assign(numNodes, vector<PathOccurrence>());
+    arcPaths.assign(numArcs, vector<PathOccurrence>());
+    
+    // the bitset rows are built only if they fit in ROW_BYTES
+    rowWords = (numArcs + 63) / 64;
+    if ((double)entries.size()*rowWords*sizeof(unsigned long long) > ROW_BYTES)
+        rowWords = 0;
+    arcRows.assign((size_t)entries.size()*rowWords, 0);
+    
+    // count the occurrences in each path, then add the path to the index
+    // N.B. the paths are visited in order, hence the index is sorted
+    vector<int> nodeCount(numNodes, 0);
+    vector<int> arcCount(numArcs, 0);
+    vector<int> nodes;
+    vector<int> arcs;
+    for (int i=0; i< (int)entries.size(); i++)
+    {
+        expand(i, nodes, arcs);
+        for (int j=0; j< (int)nodes.size(); j++)
+            nodeCount[nodes[j]]++;
+        for (int j=0; j< (int)arcs.size(); j++)
+            arcCount[arcs[j]]++;
+        if (rowWords > 0)
+            for (int j=0; j< (int)arcs.size(); j++)
+                arcRows[(size_t)i*rowWords + arcs[j]/64] |= 1ull << (arcs[j]%64);
+        
+        for (int j=0; j< (int)nodes.size(); j++)
+        {
+            if (nodeCount[nodes[j]] == 0)
+                continue;
+            nodePaths[nodes[j]].push_back(PathOccurrence(i, nodeCount[nodes[j]]));
+            nodeCount[nodes[j]] = 0;
+        }
+        for (int j=0; j< (int)arcs.size(); j++)
+        {
+            if (arcCount[arcs[j]] == 0)
+                continue;
+            arcPaths[arcs[j]].push_back(PathOccurrence(i, arcCount[arcs[j]]));
+            arcCount[arcs[j]] = 0;
+        }
+    }
+}
+
+//! number of occurrences in a path, from the paths including a node (or hyperarc)
+//! @param[in] occurrences  paths including the node (or hyperarc), in increasing index order
+//! @param[in] index        index of the path
+//! @return                 number of occurrences in the path (0 = not included)
+int PathStore::countInPath(const vector<PathOccurrence> &occurrences, int index) const
+{
+    // binary search of the path
+    int first = 0;
+    int last = (int)occurrences.size()-1;
+    while (first <= last)
+    {
+        int middle = (first+last)/2;
+        if (occurrences[middle].oPath == index)
+            return occurrences[middle].oCount;
+        if (occurrences[middle].oPath < index)
+            first = middle+1;
+        else
+            last = middle-1;
+    }
+    
+    return 0;
+}
+
+//! determine whether a path includes a hyperarc
+//! @param[in] index    index of the path
+//! @param[in] arc      index of the hyperarc
+//! @return             true if the hyperarc is chosen along the path
+bool PathStore::includesArc(int index, int arc) const
+{
+    // without bitset rows, the path is searched in the paths including the hyperarc
+    if (rowWords == 0)
+        return countInPath(arcPaths[arc], index) > 0;
+    
+    return ((arcRows[(size_t)index*rowWords + arc/64] >> (arc%64)) & 1) == 1;
+}
+
+//! first path with minimum cost below a node of the tournament tree
+//! N.B. node 1 is the root, the children of node n are nodes 2n and 2n+1, and
+//! node treeLeaves+i is the leaf of path i
+//! @param[in] node     node of the tree
+//! @return             index of the path (-1 = no paths below the node)
+int PathStore::treeWinner(int node) const
+{
+    if (node < treeLeaves)
+        return costTree[node];
+    
+    int index = node - treeLeaves;
+    return (index < (int)costs.size()) ? index : -1;
+}
+
+//! choose the first path with minimum cost below an inner node of the tournament tree
+//! N.B. the paths below the left child of a node come first: on equal costs
+//! the left winner is kept, hence the root is the first path with minimum cost
+//! @param[in] node     inner node of the tree
+void PathStore::playNode(int node)
+{
+    int left = treeWinner(2*node);
+    int right = treeWinner(2*node + 1);
+    if ((left == -1) || ((right != -1) && (costs[right] < costs[left])))
+        costTree[node] = right;
+    else
+        costTree[node] = left;
+}
+
+//! update the tournament tree after the cost of a path changed
+//! @param[in] index    index of the path
+void PathStore::updateTree(int index)
+{
+    if (treeLeaves == 0)
+        return;
+    
+    for (int node = (treeLeaves + index)/2; node > 0; node = node/2)
+        playNode(node);
+    cheapestPath = costTree[1];
+}
+
+//! forget the cheapest path (when the costs are replaced)
+void PathStore::resetCheapest()
+{
+    cheapestPath = -1;
+    treeLeaves = 0;
+    costTree.clear();
+}
+
+//! find the first path with minimum cost
+//! N.B. the tournament tree is built once, then kept up to date by the cost
+//! changes (see updatePath() and subtractCosts())
+//! @return     index of the path (-1 = no paths, or not all paths complete)
+int PathStore::findCheapest()
+{
+    if (cheapestPath != -1)
+        return cheapestPath;
+    
+    for (int i=0; i< (int)entries.size(); i++)
+        if (entries[i].eComplete == false)
+            return -1;
+    if (costs.empty() == true)
+        return -1;
+    
+    // the inner nodes are filled from the bottom of the tree
+    // N.B. at least 2 leaves: the root is an inner node, even with one path
+    treeLeaves = 2;
+    while (treeLeaves < (int)costs.size())
+        treeLeaves = 2*treeLeaves;
+    costTree.assign(treeLeaves, -1);
+    for (int node = treeLeaves-1; node > 0; node--)
+        playNode(node);
+    cheapestPath = costTree[1];
+    
+    return cheapestPath;
+}
+
+//! find the first path with minimum cost, without filling the cache
+//! N.B. for the readers sharing the paths (e.g. sessions): the root of the
+//! tournament tree, or the scan of all the costs if the tree is not built
+//! @return     index of the path (-1 = no paths, or not all paths complete)
+int PathStore::cheapest() const
+{
+    if (cheapestPath != -1)
+        return cheapestPath;
+    
+    for (int i=0; i< (int)entries.size(); i++)
+        if (entries[i].eComplete == false)
+            return -1;
+    
+    return findMinimum(costs.data(), costs.size());
+}
+
+//! update the path information (when a node is solved)
+//! @param[in] index    index of the path
+//! @param[in] solved   solved node
+//! @param[in] cost     cost to subtract from the path cost
+void PathStore::updatePath(int index, AOnode* solved, int cost)
+{
+    // keep track of solved nodes
+    checkNode(index, solved);
+    
+    // update the cost of the path
+    costs[index] = costs[index] - cost;
+    updateTree(index);
+}
+
+//! keep track of a solved node in a path (without updating its cost)
+//! @param[in] index    index of the path
+//! @param[in] solved   solved node
+void PathStore::checkNode(int index, AOnode* solved)
+{
+    // N.B. a node is solved once and all its updates of a path are consecutive:
+    // if the node is already checked, it is the last one checked in the path
+    int last = entries[index].eChecked;
+    if ((last == -1) || (checks[last].cNode != solved))
+    {
+        checks.push_back(PathCheck(entries[index].eChecked, solved));
+        entries[index].eChecked = (int)checks.size()-1;
+    }
+}
+
+//! subtract costs from several paths, updating the cheapest path
+//! N.B. each path updates the tournament tree (lower or higher cost alike)
+//! @param[in] indices  indices of the paths (each path listed once)
+//! @param[in] amounts  cost to subtract from each path
+void PathStore::subtractCosts(const vector<int> &indices, const vector<int> &amounts)
+{
+    for (int i=0; i< (int)indices.size(); i++)
+    {
+        costs[indices[i]] = costs[indices[i]] - amounts[i];
+        updateTree(indices[i]);
+    }
+}
+
+//! approximate memory used by the paths (in bytes)
+//! @return bytes used by the steps, the information and costs of the paths, the checked nodes and the index
+size_t PathStore::memoryUsage() const
+{
+    size_t bytes = steps.capacity()*sizeof(PathStep) + entries.capacity()*sizeof(PathEntry)
+        + costs.capacity()*sizeof(int) + checks.capacity()*sizeof(PathCheck)
+        + arcRows.capacity()*sizeof(unsigned long long) + costTree.capacity()*sizeof(int);
+    for (int i=0; i< (int)nodePaths.size(); i++)
+        bytes = bytes + nodePaths[i].capacity()*sizeof(PathOccurrence);
+    for (int i=0; i< (int)arcPaths.size(); i++)
+        bytes = bytes + arcPaths[i].capacity()*sizeof(PathOccurrence);
+    
+    return bytes;
+}
+
+//! estimate the memory used by paths not generated yet (in bytes)
+//! N.B. upper bound of memoryUsage() once the paths are indexed: each node
+//! of a path is counted as one step and one occurrence in each index
+//! @param[in] numPaths     number of paths (see CompiledGraph::countPaths())
+//! @param[in] totalLength  overall number of nodes in all paths
+//! @param[in] numArcs      number of hyperarcs in the graph
+//! @return                 approximate bytes used by the paths
+double PathStore::estimateMemory(double numPaths, double totalLength, int numArcs)
+{
+    double rowBytes = numPaths*((numArcs + 63) / 64)*sizeof(unsigned long long);
+    if (rowBytes > ROW_BYTES)
+        rowBytes = 0.0;
+    
+    return numPaths*(sizeof(PathEntry) + 2*sizeof(int)) + rowBytes
+        + totalLength*(sizeof(PathStep) + 2*sizeof(PathOccurrence));
+}
@@ -0,0 +1,204 @@
+//===============================================================================//
+// Name			: pathstore.h
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Description	: Paths navigating an AND-OR graph, stored sharing their common prefixes
+//===============================================================================//
+
+#ifndef PATHSTORE_H
+#define PATHSTORE_H
+
+#include "compiledgraph.h"
+#include "pathkernels.h"
+
+using namespace std;
+
+//! maximum size of the bitset rows of the paths (in bytes)
+#ifndef ROW_BYTES
+#define ROW_BYTES (64 << 20)
+#endif
+
+//! class "Path" for each unique path traversing the graph from the head to the leaves
+class Path
+{        
+    public:
+        int pIndex;                 //!< index of the path
+        int pCost;                  //!< overall cost of all the nodes in the path
+        bool pComplete;             //!< complete: the path fully traverses the graph
+        vector<AOnode*> pathNodes;  //!< set of the nodes in the path
+        vector<int> pathArcs;       //!< set of the hyperarcs in the path
+        vector<bool> checkedNodes;  //!< checked: the node has been analysed
+        
+        //! constructor
+		Path(int cost, int index);
+        
+        //! copy constructor
+        Path(const Path &toBeCopied, int index);
+        
+        //! display path information
+        void printPathInfo();
+        
+        //! add a node in the path
+        void addNode(AOnode* node);
+        
+        //! update the path information (when a node is solved)
+        void updatePath(int idNode, int cost);
+        
+        //! find the feasible node to suggest
+        AOnode* suggestNode();
+        
+        //! destructor
+		~Path()
+		{
+			//DEBUG:cout<<endl <<"Destroying Path object" <<endl;
+		}		
+};
+
+//! class "PathStep" for a hyperarc chosen along a path (shared by all paths with the same prefix)
+class PathStep
+{
+    public:
+        int sParent;                //!< previous step along the path (-1 = head node only)
+        int sArc;                   //!< position of the chosen hyperarc in the node
+        int sNode;                  //!< identifier of the node whose hyperarc has been chosen
+        
+        //! constructor
+        PathStep(int parent, int node, int arc);
+};
+
+//! class "PathEntry" for the information of a path which is not shared with other paths
+class PathEntry
+{
+    public:
+        int eLastStep;              //!< last hyperarc chosen along the path (-1 = head node only)
+        int eLength;                //!< number of nodes in the path
+        int eChecked;               //!< last solved node checked in the path (-1 = none)
+        bool eComplete;             //!< complete: the path fully traverses the graph
+        
+        //! constructor
+        PathEntry(int lastStep, int length);
+};
+
+//! class "PathCheck" for a solved node checked in a path (all its occurrences)
+class PathCheck
+{
+    public:
+        int cPrevious;              //!< solved node checked before in the same path (-1 = none)
+        AOnode* cNode;              //!< solved node
+        
+        //! constructor
+        PathCheck(int previous, AOnode* node);
+};
+
+//! class "PathOccurrence" for the occurrences of a node (or hyperarc) in a path
+class PathOccurrence
+{
+    public:
+        int oPath;                  //!< index of the path
+        int oCount;                 //!< number of occurrences in the path
+        
+        //! constructor
+        PathOccurrence(int path, int count);
+};
+
+//! class "PathStore" for the set of paths navigating the graph
+//! N.B. a path is the sequence of hyperarcs chosen from the head node: its
+//! nodes are the head node followed by the child nodes of each hyperarc, and
+//! paths created by copying another path share the steps of the copied path.
+//! The costs of the paths are stored contiguously, and the hyperarcs of each
+//! path in a fixed-width bitset row (if all rows fit in ROW_BYTES).
+//! The cheapest path is kept by a tournament tree over the costs (built by
+//! findCheapest() once all paths are complete): a cost change, lower or higher
+//! (e.g. a cost raised by AOgraph::setNodeCost()), updates the tree in time
+//! proportional to the logarithm of the number of paths
+class PathStore
+{
+    public:
+        AOnode* head;               //!< head node of all paths
+        const CompiledGraph* compiled;  //!< compiled form of the graph (hyperarcs and child nodes)
+        vector<PathStep> steps;     //!< hyperarcs chosen along the paths
+        vector<PathEntry> entries;  //!< information of each path
+        vector<int> costs;          //!< overall cost of each path (contiguous, in path order)
+        vector<PathCheck> checks;   //!< solved nodes checked in the paths
+        vector< vector<PathOccurrence> > nodePaths; //!< paths including each node, in increasing index order
+        vector< vector<PathOccurrence> > arcPaths;  //!< paths including each hyperarc, in increasing index order
+        int rowWords;               //!< number of 64-bit words of each bitset row (0 = no rows)
+        vector<unsigned long long> arcRows; //!< hyperarcs included in each path (one bitset row per path)
+        int cheapestPath;           //!< first path with minimum cost (-1 = to be found)
+        int treeLeaves;             //!< number of leaves of the tournament tree (power of 2, 0 = no tree)
+        vector<int> costTree;       //!< first path with minimum cost below each inner node of the tree (-1 = none)
+        
+        //! constructor
+        PathStore();
+        
+        //! remove all paths
+        void clear();
+        
+        //! number of paths
+        int size() const;
+        
+        //! add a path
+        int addPath(int cost, int lastStep, int length);
+        
+        //! add a hyperarc chosen after a given step
+        int addStep(int parent, int node, int arc);
+        
+        //! compute the nodes and hyperarcs in a path
+        void expand(int index, vector<int> &nodes, vector<int> &arcs) const;
+        
+        //! build a copy of a path with all its information
+        Path operator[](int index) const;
+        
+        //! determine whether a solved node is checked in a path
+        bool isChecked(int index, AOnode* node) const;
+        
+        //! index the paths including each node and hyperarc
+        void buildIndex(int numNodes, int numArcs);
+        
+        //! number of occurrences in a path, from the paths including a node (or hyperarc)
+        int countInPath(const vector<PathOccurrence> &occurrences, int index) const;
+        
+        //! determine whether a path includes a hyperarc
+        bool includesArc(int index, int arc) const;
+        
+        //! first path with minimum cost below a node of the tournament tree
+        int treeWinner(int node) const;
+        
+        //! choose the first path with minimum cost below an inner node of the tournament tree
+        void playNode(int node);
+        
+        //! update the tournament tree after the cost of a path changed
+        void updateTree(int index);
+        
+        //! forget the cheapest path (when the costs are replaced)
+        void resetCheapest();
+        
+        //! find the first path with minimum cost
+        int findCheapest();
+        
+        //! find the first path with minimum cost, without filling the cache
+        int cheapest() const;
+        
+        //! update the path information (when a node is solved)
+        void updatePath(int index, AOnode* solved, int cost);
+        
+        //! keep track of a solved node in a path (without updating its cost)
+        void checkNode(int index, AOnode* solved);
+        
+        //! subtract costs from several paths, updating the cheapest path
+        void subtractCosts(const vector<int> &indices, const vector<int> &amounts);
+        
+        //! approximate memory used by the paths (in bytes)
+        size_t memoryUsage() const;
+        
+        //! estimate the memory used by paths not generated yet (in bytes)
+        static double estimateMemory(double numPaths, double totalLength, int numArcs);
+        
+        //! destructor
+		~PathStore()
+		{
+			//DEBUG:cout<<endl <<"Destroying PathStore object" <<endl;
+		}
+};
+
+#endif
@@ -0,0 +1,222 @@
+//===============================================================================//
+// Name			: rolloutplanner.cpp
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Description	: Suggestions by Monte Carlo rollouts of the completions of an AND-OR graph
+//===============================================================================//
+
+#include <functional>
+#include <thread>
+
+#include "rolloutplanner.h"
+
+// next random number of a rollout (splitmix64: cheap to seed, hence one generator per rollout)
+static unsigned long long nextRandom(unsigned long long &state)
+{
+    state = state + 0x9E3779B97F4A7C15ull;
+    unsigned long long mixed = state;
+    mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9ull;
+    mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EBull;
+    return mixed ^ (mixed >> 31);
+}
+
+//! constructor of class RolloutScratch
+//! @param[in] numNodes     number of nodes in the graph
+RolloutScratch::RolloutScratch(int numNodes)
+{
+    visited.assign(numNodes, 0);
+    rollout = 0;
+}
+
+//! constructor of class RolloutPlanner
+//! @param[in] graph        compiled form of the graph (with the current state of its nodes)
+//! @param[in] headNode     identifier of the head node
+//! @param[in] randomness   probability of choosing a random hyperarc (instead of the greedy one)
+RolloutPlanner::RolloutPlanner(const CompiledGraph* graph, int headNode, double randomness)
+{
+    compiled = graph;
+    head = headNode;
+    exploration = randomness;
+    solved.assign(compiled->numNodes, false);
+    for (int i=0; i< compiled->numNodes; i++)
+    {
+        solved[i] = compiled->node[i]->nSolved;
+        if ((compiled->node[i]->nFeasible == true) && (solved[i] == false))
+            candidates.push_back(i);
+    }
+    computeGreedyArcs();
+}
+
+//! estimate the cost to solve each node, and choose its greedy hyperarc
+//! N.B. the estimate of a node is its cost plus the cheapest of its hyperarcs
+//! (hyperarc cost + estimates of the child nodes, a solved node costs 0):
+//! as in the solution graph engine, a shared node counts once per occurrence
+void RolloutPlanner::computeGreedyArcs()
+{
+    greedyArc.assign(compiled->numNodes, -1);
+    if ((head < 0) || (solved[head] == true))
+        return;
+    
+    // visit the nodes not solved in post-order (child nodes first), without recursion
+    // state: 0 = not visited, 1 = child nodes pending, 2 = estimated
+    vector<double> estimate(compiled->numNodes, 0.0);
+    vector<char> state(compiled->numNodes, 0);
+    vector<int> toVisit(1, head);
+    while (toVisit.empty() == false)
+    {
+        int current = toVisit.back();
+        if (state[current] == 0)
+        {
+            state[current] = 1;
+            for (int c = compiled->childOffset[compiled->arcOffset[current]];
+                 c < compiled->childOffset[compiled->arcOffset[current+1]]; c++)
+            {
+                int child = compiled->childNode[c];
+                if ((solved[child] == false) && (state[child] == 0))
+                    toVisit.push_back(child);
+            }
+            continue;
+        }
+        toVisit.pop_back();
+        if (state[current] == 2)
+            continue;
+        state[current] = 2;
+        
+        double bestCost = 0.0;
+        for (int a = compiled->arcOffset[current]; a < compiled->arcOffset[current+1]; a++)
+        {
+            double cost = compiled->arcCost[a];
+            for (int c = compiled->childOffset[a]; c < compiled->childOffset[a+1]; c++)
+                cost = cost + estimate[compiled->childNode[c]];
+            if ((greedyArc[current] == -1) || (cost < bestCost))
+            {
+                greedyArc[current] = a;
+                bestCost = cost;
+            }
+        }
+        estimate[current] = compiled->nodeCost[current] + bestCost;
+    }
+}
+
+//! cost to solve a candidate now (with its cheapest hyperarc whose child nodes are solved)
+//! @param[in] node     identifier of the candidate
+//! @return             node cost + hyperarc cost
+int RolloutPlanner::solveCost(int node) const
+{
+    bool found = false;
+    int arcCost = 0;
+    for (int a = compiled->arcOffset[node]; a < compiled->arcOffset[node+1]; a++)
+    {
+        bool allSolved = true;
+        for (int c = compiled->childOffset[a]; (c < compiled->childOffset[a+1]) && (allSolved == true); c++)
+            allSolved = solved[compiled->childNode[c]];
+        if ((allSolved == true) && ((found == false) || (compiled->arcCost[a] < arcCost)))
+        {
+            arcCost = compiled->arcCost[a];
+            found = true;
+        }
+    }
+    
+    return compiled->nodeCost[node] + arcCost;
+}
+
+//! simulate solving a candidate, then completing the graph
+//! @param[in] candidate    identifier of the node solved first
+//! @param[in] seed         seed of the random choices of the rollout
+//! @param[in,out] scratch  memory of the rollouts of the thread
+//! @return                 cost of the candidate + cost of the nodes solved to complete the graph
+long long RolloutPlanner::rollout(int candidate, unsigned long long seed, RolloutScratch &scratch) const
+{
+    // 1. solve the candidate
+    // 2. from the head node, solve each node not solved yet (once) through
+    //    the greedy hyperarc, or a random one, and visit its child nodes
+    scratch.rollout++;
+    long long cost = solveCost(candidate);
+    scratch.visited[candidate] = scratch.rollout;
+    scratch.toVisit.assign(1, head);
+    while (scratch.toVisit.empty() == false)
+    {
+        int current = scratch.toVisit.back();
+        scratch.toVisit.pop_back();
+        if ((solved[current] == true) || (scratch.visited[current] == scratch.rollout))
+            continue;
+        scratch.visited[current] = scratch.rollout;
+        
+        int firstArc = compiled->arcOffset[current];
+        int numNodeArcs = compiled->arcOffset[current+1] - firstArc;
+        if (numNodeArcs == 0)
+        {
+            cost = cost + compiled->nodeCost[current];
+            continue;
+        }
+        int arc = greedyArc[current];
+        if ((arc == -1) || ((nextRandom(seed) >> 11) * (1.0/9007199254740992.0) < exploration))
+            arc = firstArc + (int)(nextRandom(seed) % (unsigned long long)numNodeArcs);
+        cost = cost + compiled->nodeCost[current] + compiled->arcCost[arc];
+        scratch.toVisit.insert(scratch.toVisit.end(), compiled->childNode.begin() + compiled->childOffset[arc],
+            compiled->childNode.begin() + compiled->childOffset[arc+1]);
+    }
+    
+    return cost;
+}
+
+//! run a range of rollouts, adding their costs to the sums of the candidates
+//! N.B. rollout r solves candidate (r % candidates) with its own seed: the
+//! scores are the same whatever the number of threads
+//! @param[in] first    first rollout of the range
+//! @param[in] last     rollout after the range
+//! @param[in] seed     seed of all rollouts
+//! @param[out] sums    sum of the rollout costs of each candidate
+void RolloutPlanner::work(int first, int last, unsigned int seed, vector<long long> &sums) const
+{
+    RolloutScratch scratch(compiled->numNodes);
+    for (int r = first; r < last; r++)
+    {
+        int c = r % candidates.size();
+        sums[c] = sums[c] + rollout(candidates[c], ((unsigned long long)seed << 32) + r, scratch);
+    }
+}
+
+//! score the candidates with a budget of rollouts, and suggest the best one
+//! @param[in] numRollouts  number of rollouts, shared by the candidates (at least one each)
+//! @param[in] numThreads   number of threads running the rollouts
+//! @param[in] seed         seed of the random choices
+//! @return                 identifier of the candidate with minimum score (-1 = no candidates)
+int RolloutPlanner::suggest(int numRollouts, int numThreads, unsigned int seed)
+{
+    int numCandidates = candidates.size();
+    scores.assign(numCandidates, 0.0);
+    if (numCandidates == 0)
+        return -1;
+    if (numRollouts < numCandidates)
+        numRollouts = numCandidates;
+    if (numThreads > numRollouts)
+        numThreads = numRollouts;
+    if (numThreads < 1)
+        numThreads = 1;
+    
+    // each thread runs a contiguous range of rollouts, with its own sums
+    // N.B. the sums are integers: they do not depend on the order of the rollouts
+    vector< vector<long long> > sums(numThreads, vector<long long>(numCandidates, 0));
+    vector<thread> threads;
+    for (int t=1; t< numThreads; t++)
+        threads.push_back(thread(&RolloutPlanner::work, this, (int)((long long)numRollouts*t/numThreads),
+            (int)((long long)numRollouts*(t+1)/numThreads), seed, ref(sums[t])));
+    work(0, numRollouts/numThreads, seed, sums[0]);
+    for (int t=0; t< (int)threads.size(); t++)
+        threads[t].join();
+    
+    int best = 0;
+    for (int c=0; c< numCandidates; c++)
+    {
+        long long total = 0;
+        for (int t=0; t< numThreads; t++)
+            total = total + sums[t][c];
+        int count = numRollouts/numCandidates + ((c < numRollouts % numCandidates) ? 1 : 0);
+        scores[c] = (double)total / count;
+        if (scores[c] < scores[best])
+            best = c;
+    }
+    
+    return candidates[best];
+}
@@ -0,0 +1,71 @@
+//===============================================================================//
+// Name			: rolloutplanner.h
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Description	: Suggestions by Monte Carlo rollouts of the completions of an AND-OR graph
+//===============================================================================//
+
+#ifndef ROLLOUTPLANNER_H
+#define ROLLOUTPLANNER_H
+
+#include "compiledgraph.h"
+
+using namespace std;
+
+//! class "RolloutScratch" for the memory of the rollouts of one thread
+class RolloutScratch
+{
+    public:
+        vector<int> visited;        //!< rollout which last visited each node
+        vector<int> toVisit;        //!< nodes to visit in the current rollout
+        int rollout;                //!< number of the current rollout (of this thread)
+        
+        //! constructor
+        RolloutScratch(int numNodes);
+};
+
+//! class "RolloutPlanner" for the suggestions of the rollout strategy
+//! N.B. the planner refers to the state of the graph at its creation. A
+//! rollout solves one candidate (a feasible node not solved yet), then
+//! completes the graph from the head node: each node not solved yet is solved
+//! once, through the greedy hyperarc or (with probability "exploration") a
+//! random one. The score of a candidate is its average completion cost
+class RolloutPlanner
+{
+    protected:
+        const CompiledGraph* compiled;  //!< compiled form of the graph
+        int head;                   //!< identifier of the head node
+        vector<bool> solved;        //!< solved: the node is solved in the graph
+        vector<int> greedyArc;      //!< cheapest hyperarc of each node (estimated cost, -1 = terminal node)
+        double exploration;         //!< probability of choosing a random hyperarc
+        
+        //! estimate the cost to solve each node, and choose its greedy hyperarc
+        void computeGreedyArcs();
+        
+        //! cost to solve a candidate now (with its cheapest hyperarc whose child nodes are solved)
+        int solveCost(int node) const;
+        
+        //! simulate solving a candidate, then completing the graph
+        long long rollout(int candidate, unsigned long long seed, RolloutScratch &scratch) const;
+        
+        //! run a range of rollouts, adding their costs to the sums of the candidates
+        void work(int first, int last, unsigned int seed, vector<long long> &sums) const;
+    
+    public:
+        vector<int> candidates;     //!< feasible nodes not solved yet, in identifier order
+        vector<double> scores;      //!< average completion cost of each candidate (after suggest())
+        
+        //! constructor
+        RolloutPlanner(const CompiledGraph* graph, int headNode, double randomness);
+        
+        //! score the candidates with a budget of rollouts, and suggest the best one
+        int suggest(int numRollouts, int numThreads, unsigned int seed);
+        
+        //! destructor
+		~RolloutPlanner()
+		{
+			//DEBUG:cout<<endl <<"Destroying RolloutPlanner object" <<endl;
+		}
+};
+
+#endif
@@ -0,0 +1,52 @@
+//===============================================================================//
+// Name			: session.cpp
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Description	: Assembly session on an AND-OR graph shared with other sessions
+//===============================================================================//
+
+#include "session.h"
+
+//! constructor of class Session
+//! @param[in] graph    shared graph (loaded with the paths engine, no node solved)
+Session::Session(const AOgraph &graph)
+{
+    // raise an error if the shared graph cannot be used by the session
+    if (graph.gEngine != ENGINE_PATHS)
+    {
+        ENDOR_MESSAGE("[ERROR] A session requires a graph using the paths engine.");
+        return;
+    }
+    if ((graph.head == NULL) || (graph.paths.size() == 0))
+    {
+        ENDOR_MESSAGE("[ERROR] There are no paths navigating the graph. "
+            <<"Did you load the graph?");
+        return;
+    }
+    const CompiledGraph &compiled = graph.compiled;
+    for (int i=0; i< compiled.numNodes; i++)
+    {
+        if (compiled.node[i]->nSolved == true)
+        {
+            ENDOR_MESSAGE("[ERROR] The node " <<compiled.node[i]->nName <<" of the shared graph is solved. "
+                <<"A session requires a graph with no node solved.");
+            return;
+        }
+    }
+    
+    // the session starts from the state of the shared graph
+    attach(graph);
+}
+
+//! approximate memory used by the session (in bytes)
+//! @return bytes used by the node bits, the cost changes and the last updated paths
+size_t Session::memoryUsage() const
+{
+    // N.B. each entry of the cost changes also costs a node of the hash table
+    size_t bytes = sizeof(Session) + 3*(solved.capacity()/8)
+        + costDeltas.size()*(2*sizeof(int) + 2*sizeof(void*))
+        + costDeltas.bucket_count()*sizeof(void*)
+        + (pIndices.capacity() + pUpdate.capacity())*sizeof(int);
+    
+    return bytes;
+}
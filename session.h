@@ -0,0 +1,36 @@
+//===============================================================================//
+// Name			: session.h
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Description	: Assembly session on an AND-OR graph shared with other sessions
+//===============================================================================//
+
+#ifndef SESSION_H
+#define SESSION_H
+
+#include "statedelta.h"
+
+using namespace std;
+
+//! class "Session" for one assembly (e.g., one station) on a graph shared with other sessions
+//! N.B. the session only reads the shared graph (compiled graph and paths): it
+//! keeps its own solved and feasible nodes and the changes of the path costs.
+//! Sessions can be used from different threads without locks, as long as no
+//! node of the shared graph is solved (and no graph is loaded) meanwhile
+class Session : public StateDelta
+{
+    public:
+        //! constructor
+        Session(const AOgraph &graph);
+        
+        //! approximate memory used by the session (in bytes)
+        size_t memoryUsage() const;
+        
+        //! destructor
+		~Session()
+		{
+			//DEBUG:cout<<endl <<"Destroying Session object" <<endl;
+		}
+};
+
+#endif
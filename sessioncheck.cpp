@@ -0,0 +1,228 @@
+//===============================================================================//
+// Name			: sessioncheck.cpp
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Version		: 1.0
+// Description	: Check of the sessions and of the batch solve against nodes solved one at a time
+//===============================================================================//
+
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <thread>
+
+#include "aograph.h"
+#include "graphgenerator.h"
+#include "session.h"
+
+using namespace std;
+
+// load a graph without displaying its events
+void loadQuiet(AOgraph &graph, const string &fileName)
+{
+    graph.removeObserver(&graph.textObserver);
+    graph.loadFromFile(fileName);
+}
+
+// choose the nodes solved by an assembly, in order, until the graph is solved
+vector<int> chooseNodes(const string &fileName, mt19937 &generator)
+{
+    AOgraph graph("CHOICE");
+    loadQuiet(graph, fileName);
+    vector<int> nodes;
+    while (graph.head->nSolved == false)
+    {
+        vector<AOnode*> frontier = graph.getFrontier();
+        nodes.push_back(frontier[generator() % frontier.size()]->nId);
+        graph.solveById(nodes.back());
+    }
+    
+    return nodes;
+}
+
+// display the state of a graph (costs of the paths, frontier, optimal path, suggestions)
+string describe(AOgraph &graph)
+{
+    string text = "costs";
+    for (int i=0; i< graph.paths.size(); i++)
+        text = text + " " + to_string(graph.paths.costs[i]);
+    text = text + ", frontier";
+    vector<AOnode*> frontier = graph.getFrontier();
+    for (int i=0; i< (int)frontier.size(); i++)
+        text = text + " " + to_string(frontier[i]->nId);
+    if (graph.head->nSolved == true)
+        return text;
+    
+    return text + ", optimal " + to_string(graph.paths.findCheapest()) + ", suggestions "
+        + graph.suggestNext(true) + " " + graph.suggestNext(false);
+}
+
+// display the state of a session, as describe() displays a graph
+string describe(Session &session, const AOgraph &graph)
+{
+    string text = "costs";
+    for (int i=0; i< graph.paths.size(); i++)
+        text = text + " " + to_string(session.pathCost(i));
+    text = text + ", frontier";
+    vector<int> frontier = session.getFrontier();
+    for (int i=0; i< (int)frontier.size(); i++)
+        text = text + " " + to_string(frontier[i]);
+    if (session.isSolved(graph.head->nId) == true)
+        return text;
+    
+    return text + ", optimal " + to_string(session.findOptimalPath()) + ", suggestions "
+        + session.suggestNext(true) + " " + session.suggestNext(false);
+}
+
+// solve nodes on a session, displaying its state after each node
+void runSession(const AOgraph &graph, const vector<int> &nodes, vector<string> &states)
+{
+    Session session(graph);
+    for (int i=0; i< (int)nodes.size(); i++)
+    {
+        session.solveById(nodes[i]);
+        states.push_back(describe(session, graph));
+    }
+}
+
+// check the sessions of one graph, run on several threads, against graphs solving the same nodes
+int checkSessions(const string &fileName, unsigned int seed)
+{
+    // the reference states are computed one session at a time
+    int numSessions = 4;
+    mt19937 generator(seed);
+    vector< vector<int> > nodes(numSessions);
+    vector< vector<string> > expected(numSessions);
+    for (int s=0; s< numSessions; s++)
+    {
+        nodes[s] = chooseNodes(fileName, generator);
+        AOgraph graph("SEQUENTIAL");
+        loadQuiet(graph, fileName);
+        for (int i=0; i< (int)nodes[s].size(); i++)
+        {
+            graph.solveById(nodes[s][i]);
+            expected[s].push_back(describe(graph));
+        }
+    }
+    
+    // N.B. the sessions share the graph and run at the same time
+    AOgraph shared("SHARED");
+    loadQuiet(shared, fileName);
+    vector< vector<string> > states(numSessions);
+    vector<thread> threads;
+    for (int s=0; s< numSessions; s++)
+        threads.push_back(thread(runSession, cref(shared), cref(nodes[s]), ref(states[s])));
+    for (int s=0; s< numSessions; s++)
+        threads[s].join();
+    
+    int failed = 0;
+    for (int s=0; s< numSessions; s++)
+    {
+        for (int i=0; i< (int)expected[s].size(); i++)
+        {
+            if (states[s][i] != expected[s][i])
+            {
+                cout<<"[ERROR] " <<fileName <<": session " <<s <<" differs after " <<i+1 <<" solved nodes." <<endl;
+                failed++;
+                break;
+            }
+        }
+    }
+    
+    return failed;
+}
+
+// check the nodes solved in batches against the same nodes solved one at a time
+// N.B. a batch keeps the updates of its last solved node: the short-sighted
+// strategy suggests the same node too
+int checkBatches(const string &fileName, PathEngine engine, unsigned int seed)
+{
+    mt19937 generator(seed);
+    vector<int> nodes = chooseNodes(fileName, generator);
+    AOgraph batch("BATCH", engine);
+    AOgraph single("SINGLE", engine);
+    loadQuiet(batch, fileName);
+    loadQuiet(single, fileName);
+    
+    int failed = 0;
+    for (int first = 0; first < (int)nodes.size(); )
+    {
+        // a batch of 1 to 5 nodes, sometimes with a node solved already
+        int last = min(first + 1 + (int)(generator() % 5), (int)nodes.size());
+        vector<string> names;
+        if ((first > 0) && (generator() % 4 == 0))
+            names.push_back(single.graph[nodes[generator() % first]].nName);
+        for (int i = first; i < last; i++)
+            names.push_back(single.graph[nodes[i]].nName);
+        
+        int numSolved = batch.solveMany(names);
+        for (int i = first; i < last; i++)
+            single.solveById(nodes[i]);
+        
+        string what = fileName + " (engine " + to_string(engine) + ") after " + to_string(last) + " solved nodes";
+        if (numSolved != last - first)
+        {
+            cout<<"[ERROR] " <<what <<": the batch solved " <<numSolved <<" nodes instead of " <<last - first <<"." <<endl;
+            failed++;
+        }
+        for (int i=0; i< (int)single.graph.size(); i++)
+        {
+            if ((batch.graph[i].nSolved != single.graph[i].nSolved) || (batch.graph[i].nFeasible != single.graph[i].nFeasible))
+            {
+                cout<<"[ERROR] " <<what <<": the state of node " <<single.graph[i].nName <<" differs." <<endl;
+                failed++;
+                break;
+            }
+        }
+        if ((engine == ENGINE_PATHS) && (batch.paths.costs != single.paths.costs))
+        {
+            cout<<"[ERROR] " <<what <<": the costs of the paths differ." <<endl;
+            failed++;
+        }
+        if ((single.head->nSolved == false) && ((batch.suggestNext(true) != single.suggestNext(true))
+            || (batch.suggestNext(false) != single.suggestNext(false))))
+        {
+            cout<<"[ERROR] " <<what <<": the suggestions differ." <<endl;
+            failed++;
+        }
+        first = last;
+    }
+    
+    return failed;
+}
+
+int main(int argc, char **argv)
+{
+    int numGraphs = (argc > 1) ? atoi(argv[1]) : 8;
+    int failed = 0;
+    int numChecked = 0;
+    for (int i=0; i< numGraphs; i++)
+    {
+        // trees and graphs with shared nodes
+        GraphSettings settings;
+        settings.depth = 2 + (i / 2) % 2;
+        settings.orBranching = 2 + (i / 4) % 2;
+        settings.andFanout = 2;
+        settings.sharing = (i % 2 == 0) ? 0.0 : 0.4;
+        settings.seed = i+1;
+        GraphGenerator generator(settings);
+        generator.generate();
+        if (generator.countPaths() > 5000)
+            continue;
+        string fileName = "sessioncheck_" + settings.graphName() + ".txt";
+        if (generator.writeDescription(fileName) == false)
+            return 1;
+        
+        failed = failed + checkSessions(fileName, settings.seed);
+        failed = failed + checkBatches(fileName, ENGINE_PATHS, settings.seed);
+        failed = failed + checkBatches(fileName, ENGINE_SOLUTION_GRAPH, settings.seed);
+        numChecked++;
+        remove(fileName.c_str());
+    }
+    
+    cout<<"[REPORT] " <<numChecked <<" graphs: " <<failed <<" failed checks of the sessions and batches." <<endl;
+    
+    return (failed == 0) ? 0 : 1;
+}
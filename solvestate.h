@@ -0,0 +1,39 @@
+//===============================================================================//
+// Name			: solvestate.h
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Description	: Binary snapshot of the solve state of an AND-OR graph
+//===============================================================================//
+
+#ifndef SOLVESTATE_H
+#define SOLVESTATE_H
+
+//! identifier and version of the solve state format
+#define STATE_MAGIC "ENDORSTA"
+#define STATE_VERSION 1
+
+//! class "StateHeader" for the header of a solve state
+//! N.B. the header is followed by the sections of the state, in this order:
+//! solved nodes (bitset), feasible nodes (bitset), path costs, hyperarcs and
+//! benefits (hyperarcs with non-zero benefit only), updated paths, updates,
+//! checks (padded to 4 bytes). The checks are stored as runs of paths checked
+//! for the same node, in the order they were made: identifier of the node,
+//! number of paths and differences between consecutive path indices, all as
+//! variable-length integers
+class StateHeader
+{
+    public:
+        char sMagic[8];             //!< identifier of the format (STATE_MAGIC)
+        int sVersion;               //!< version of the format (STATE_VERSION)
+        int sEngine;                //!< engine of the graph
+        int sNumNodes;              //!< number of nodes of the graph
+        int sNumArcs;               //!< number of hyperarcs of the graph
+        int sNumPaths;              //!< number of paths
+        int sNumSteps;              //!< number of steps shared by the paths
+        int sNumBenefits;           //!< number of hyperarcs with non-zero benefit
+        int sNumUpdated;            //!< number of paths updated by the last solved node
+        int sNumChecks;             //!< number of solved nodes checked in the paths
+        int sCheckBytes;            //!< length of the checks section (not padded)
+};
+
+#endif
@@ -0,0 +1,154 @@
+//===============================================================================//
+// Name			: statecheck.cpp
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Version		: 1.0
+// Description	: Check of the save and restore of the solve state, with corrupted blobs
+//===============================================================================//
+
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+
+#include "aograph.h"
+#include "graphgenerator.h"
+
+using namespace std;
+
+// load a graph without displaying its events
+void loadQuiet(AOgraph &graph, const string &fileName)
+{
+    graph.removeObserver(&graph.textObserver);
+    graph.loadFromFile(fileName);
+}
+
+// check that a blob is rejected and leaves the state of the graph unchanged
+bool checkRejected(AOgraph &graph, const vector<char> &blob, const vector<char> &current, const string &what)
+{
+    vector<char> after;
+    bool restored = graph.restoreState(blob);
+    graph.saveState(after);
+    if ((restored == true) || (after != current))
+    {
+        cout<<"[ERROR] " <<what <<": " <<(restored ? "accepted" : "state changed") <<"." <<endl;
+        return false;
+    }
+    
+    return true;
+}
+
+// change one counter of the header of a blob
+vector<char> forgeHeader(const vector<char> &blob, int StateHeader::*field, int value)
+{
+    StateHeader header;
+    memcpy(&header, blob.data(), sizeof(StateHeader));
+    header.*field = value;
+    vector<char> forged = blob;
+    memcpy(forged.data(), &header, sizeof(StateHeader));
+    
+    return forged;
+}
+
+// check the save and restore of the solve state on one graph
+int checkGraph(const string &fileName, unsigned int seed)
+{
+    int failed = 0;
+    
+    // solve some nodes of the frontier, then save the state
+    AOgraph solvedGraph("SOLVED");
+    loadQuiet(solvedGraph, fileName);
+    mt19937 generator(seed);
+    for (int i=0; i< 4; i++)
+    {
+        vector<AOnode*> frontier = solvedGraph.getFrontier();
+        if (frontier.empty() == true)
+            break;
+        solvedGraph.solveByName(frontier[generator() % frontier.size()]->nName);
+    }
+    vector<char> blob;
+    solvedGraph.saveState(blob);
+    
+    // a graph loaded again restores the same state
+    AOgraph graph("RESTORED");
+    loadQuiet(graph, fileName);
+    vector<char> initial;
+    graph.saveState(initial);
+    vector<char> restored;
+    if (graph.restoreState(blob) == true)
+        graph.saveState(restored);
+    if (restored != blob)
+    {
+        cout<<"[ERROR] " <<fileName <<": the restored state differs from the saved one." <<endl;
+        failed++;
+    }
+    graph.restoreState(initial);
+    
+    // truncated blobs
+    for (int length = 0; length < (int)blob.size(); length++)
+        if (checkRejected(graph, vector<char>(blob.begin(), blob.begin() + length), initial,
+            fileName + ": blob truncated to " + to_string(length) + " bytes") == false)
+            failed++;
+    
+    // forged counters of the header (sizes out of range, or not matching the blob)
+    StateHeader header;
+    memcpy(&header, blob.data(), sizeof(StateHeader));
+    int StateHeader::*counters[] = {&StateHeader::sNumBenefits, &StateHeader::sNumUpdated,
+        &StateHeader::sNumChecks, &StateHeader::sCheckBytes};
+    const char* names[] = {"benefits", "updated paths", "checks", "check bytes"};
+    for (int i=0; i< 4; i++)
+    {
+        int values[] = {-1, INT_MIN, INT_MAX, INT_MAX/4, header.*counters[i] + 1};
+        for (int v=0; v< 5; v++)
+            if (checkRejected(graph, forgeHeader(blob, counters[i], values[v]), initial,
+                fileName + ": " + names[i] + " = " + to_string(values[v])) == false)
+                failed++;
+    }
+    
+    // checks claimed without the bytes to store them, in a blob of consistent size
+    if (checkRejected(graph, forgeHeader(blob, &StateHeader::sNumChecks, header.sCheckBytes + 1), initial,
+        fileName + ": more checks than check bytes") == false)
+        failed++;
+    
+    // random bytes after the header: the blob is rejected or restored, never a crash
+    uniform_int_distribution<int> position(sizeof(StateHeader), blob.size()-1);
+    for (int i=0; i< 200; i++)
+    {
+        vector<char> forged = blob;
+        forged[position(generator)] ^= (char)(1 + generator() % 255);
+        graph.restoreState(forged);
+        graph.restoreState(initial);
+    }
+    
+    return failed;
+}
+
+int main(int argc, char **argv)
+{
+    int numGraphs = (argc > 1) ? atoi(argv[1]) : 6;
+    int failed = 0;
+    for (int i=0; i< numGraphs; i++)
+    {
+        // trees and graphs with shared nodes
+        GraphSettings settings;
+        settings.depth = 3;
+        settings.orBranching = 2;
+        settings.andFanout = 2;
+        settings.sharing = (i % 2 == 0) ? 0.0 : 0.4;
+        settings.seed = i+1;
+        GraphGenerator generator(settings);
+        generator.generate();
+        string fileName = "statecheck_" + settings.graphName() + ".txt";
+        if (generator.writeDescription(fileName) == false)
+            return 1;
+        
+        failed = failed + checkGraph(fileName, settings.seed);
+        remove(fileName.c_str());
+    }
+    
+    cout<<"[REPORT] " <<numGraphs <<" graphs: " <<failed <<" failed checks of the solve state." <<endl;
+    
+    return (failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,294 @@
+//===============================================================================//
+// Name			: statedelta.cpp
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Description	: Changes to the solve state of an AND-OR graph, kept apart from the graph
+//===============================================================================//
+
+#include "statedelta.h"
+
+//! constructor of class StateDelta
+StateDelta::StateDelta()
+{
+    aograph = NULL;
+    ownUpdates = false;
+}
+
+//! use the current state of a graph as the base of the changes
+//! @param[in] graph    graph whose current state is the base of the changes (paths engine)
+void StateDelta::attach(const AOgraph &graph)
+{
+    aograph = &graph;
+    reset();
+}
+
+//! drop all changes (back to the state of the graph)
+void StateDelta::reset()
+{
+    if (aograph == NULL)
+        return;
+    
+    int numNodes = aograph->compiled.numNodes;
+    solved.assign(numNodes, false);
+    feasible.assign(numNodes, false);
+    updated.assign(numNodes, false);
+    costDeltas.clear();
+    ownUpdates = false;
+    pIndices.clear();
+    pUpdate.clear();
+}
+
+//! update the feasibility status of the parents of a solved node
+//! N.B. there are no counters of the child nodes not solved yet: the child
+//! nodes of each hyperarc including the solved node are checked instead
+//! @param[in] idNode   identifier of the solved node
+void StateDelta::updateParentsFeasibility(int idNode)
+{
+    // a parent becomes feasible when all child nodes of one of its hyperarcs
+    // are solved, in the graph or on top of it
+    const CompiledGraph &compiled = aograph->compiled;
+    for (int k = compiled.parentOffset[idNode]; k < compiled.parentOffset[idNode+1]; k++)
+    {
+        int parent = compiled.parentNode[k];
+        if (isFeasible(parent) == true)
+            continue;
+        
+        int arc = compiled.parentArc[k];
+        bool allSolved = true;
+        for (int c = compiled.childOffset[arc]; (c < compiled.childOffset[arc+1]) && (allSolved == true); c++)
+            allSolved = isSolved(compiled.childNode[c]);
+        if (allSolved == true)
+            feasible[parent] = true;
+    }
+}
+
+//! determine whether a solved node is checked in a path
+//! N.B. as in AOgraph::updatePaths(), a node solved on top of the graph is
+//! checked if solving it updated the paths and the path includes a hyperarc
+//! from one of its parents
+//! @param[in] index    index of the path
+//! @param[in] idNode   identifier of the node
+//! @return             true if the node is checked in the path (in the graph or on top of it)
+bool StateDelta::isChecked(int index, int idNode) const
+{
+    const CompiledGraph &compiled = aograph->compiled;
+    if (aograph->paths.isChecked(index, compiled.node[idNode]) == true)
+        return true;
+    if (updated[idNode] == false)
+        return false;
+    
+    for (int k = compiled.parentOffset[idNode]; k < compiled.parentOffset[idNode+1]; k++)
+        if ((compiled.isLink(idNode, k) == true)
+            && (aograph->paths.includesArc(index, compiled.arcIndex[compiled.parentArc[k]]) == true))
+            return true;
+    
+    return false;
+}
+
+//! find the feasible node to suggest along a path
+//! @param[in] index    index of the path
+//! @return             identifier of the node to suggest (-1 = no suggestion possible)
+int StateDelta::suggestNode(int index) const
+{
+    vector<int> nodes;
+    vector<int> arcs;
+    aograph->paths.expand(index, nodes, arcs);
+    
+    // same rationale as Path::suggestNode(): move along the path from the
+    // leaves to the head and choose the first feasible & not-checked node
+    for (int i = (int)nodes.size()-1; i > -1; i--)
+        if ((isFeasible(nodes[i]) == true) && (isChecked(index, nodes[i]) == false))
+            return nodes[i];
+    
+    ENDOR_MESSAGE("[ERROR] No suggestion possible.");
+    return -1;
+}
+
+//! suggest the node to solve
+//! N.B. the observers of the graph are not notified
+//! @param[in] strategy     "0" = short-sighted, "1" = long-sighted
+//! @return                 name of the suggested node
+string StateDelta::suggestNext(bool strategy)
+{
+    if (aograph == NULL)
+        return "";
+    
+    // issue a warning if the graph has been solved already
+    if (isSolved(aograph->head->nId) == true)
+    {
+        ENDOR_MESSAGE("[WARNING] The graph is solved. No suggestion possible.");
+        return "end";
+    }
+    
+    // same strategies as AOgraph::suggestNext(): without updates on top of
+    // the graph, the last updates are the ones of the graph
+    int optimalPathIndex = 0;
+    if (strategy == false)
+    {
+        if (ownUpdates == true)
+            optimalPathIndex = AOgraph::findShortSightedPath(pIndices, pUpdate);
+        else
+            optimalPathIndex = AOgraph::findShortSightedPath(aograph->pIndices, aograph->pUpdate);
+    }
+    else
+        optimalPathIndex = findOptimalPath();
+    if (optimalPathIndex == -1)
+        return "";
+    
+    int suggestion = suggestNode(optimalPathIndex);
+    if (suggestion == -1)
+        return "";
+    
+    return aograph->compiled.node[suggestion]->nName;
+}
+
+//! solve a node, finding it by name
+//! @param[in] nameNode    name of the node
+void StateDelta::solveByName(string nameNode)
+{
+    if (aograph == NULL)
+        return;
+    
+    int found = aograph->nameIndex.find(nameNode);
+    if (found == -1)
+    {
+        ENDOR_MESSAGE("[Warning] Name not found."
+            <<"Did you really look for " <<nameNode <<"?");
+        return;
+    }
+    
+    solveById(found);
+}
+
+//! solve a node, finding it by identifier
+//! @param[in] idNode      identifier of the node
+void StateDelta::solveById(int idNode)
+{
+    if (aograph == NULL)
+        return;
+    
+    // raise an error if the identifier is out of bounds
+    if ((idNode < 0) || (idNode >= aograph->compiled.numNodes))
+    {
+        ENDOR_MESSAGE("[ERROR] The graph has only " <<aograph->compiled.numNodes <<" nodes. "
+            <<"Node identifier " <<idNode <<" does not exist.");
+        return;
+    }
+    
+    // same checks as AOnode::setSolved()
+    if (isSolved(idNode) == true)
+    {
+        ENDOR_MESSAGE("[WARNING] The node is already solved.");
+        return;
+    }
+    if (isFeasible(idNode) == false)
+    {
+        ENDOR_MESSAGE("[ERROR] The node is not feasible. Are you sure it is solved?");
+        return;
+    }
+    solved[idNode] = true;
+    updateParentsFeasibility(idNode);
+    
+    // report that the graph has been solved if the solved node is the head node
+    if (isSolved(aograph->head->nId) == true)
+    {
+        ENDOR_MESSAGE("[REPORT] The graph is solved (head node solved).");
+        return;
+    }
+    
+    // the updates of the paths are kept apart, the paths of the graph are not modified
+    vector<int> subtracts;
+    aograph->computePathUpdates(*aograph->compiled.node[idNode], pIndices, pUpdate, subtracts);
+    for (int i=0; i < (int)pIndices.size(); i++)
+        costDeltas[pIndices[i]] += subtracts[i];
+    updated[idNode] = true;
+    ownUpdates = true;
+}
+
+//! find the feasible nodes not solved yet
+//! @return     identifiers of the nodes which can be solved now, in identifier order
+vector<int> StateDelta::getFrontier() const
+{
+    vector<int> nodes;
+    for (int i=0; i< (int)solved.size(); i++)
+        if ((isFeasible(i) == true) && (isSolved(i) == false))
+            nodes.push_back(i);
+    
+    return nodes;
+}
+
+//! determine whether a node is solved
+//! @param[in] idNode   identifier of the node
+//! @return             true if the node is solved in the graph or on top of it
+bool StateDelta::isSolved(int idNode) const
+{
+    return (solved[idNode] == true) || (aograph->compiled.node[idNode]->nSolved == true);
+}
+
+//! determine whether a node is feasible
+//! @param[in] idNode   identifier of the node
+//! @return             true if the node is feasible in the graph or on top of it
+bool StateDelta::isFeasible(int idNode) const
+{
+    return (feasible[idNode] == true) || (aograph->compiled.node[idNode]->nFeasible == true);
+}
+
+//! overall cost of a path
+//! @param[in] index    index of the path
+//! @return             cost of the path in the graph, minus the costs subtracted on top of it
+int StateDelta::pathCost(int index) const
+{
+    int cost = aograph->paths.costs[index];
+    unordered_map<int, int>::const_iterator delta = costDeltas.find(index);
+    if (delta != costDeltas.end())
+        cost = cost - delta->second;
+    
+    return cost;
+}
+
+//! find the optimal path (long-sighted strategy)
+//! N.B. the cheapest path of the graph is read without filling its cache
+//! (which belongs to the graph): the graph is never written
+//! @return index of the optimal path (first path with minimum cost, -1 = no paths)
+int StateDelta::findOptimalPath() const
+{
+    if (aograph == NULL)
+        return -1;
+    
+    const PathStore &paths = aograph->paths;
+    int best = paths.cheapest();
+    if ((best == -1) || (costDeltas.empty() == true))
+        return best;
+    
+    // 1. if the cost of the cheapest path of the graph does not increase, the
+    //    paths not updated on top of the graph cannot be cheaper (nor come
+    //    first): only the updated paths are compared with it
+    // 2. otherwise, all paths are compared
+    int bestCost = pathCost(best);
+    if (bestCost > paths.costs[best])
+    {
+        best = 0;
+        bestCost = pathCost(0);
+        for (int i=1; i< paths.size(); i++)
+        {
+            int cost = pathCost(i);
+            if (cost < bestCost)
+            {
+                best = i;
+                bestCost = cost;
+            }
+        }
+        return best;
+    }
+    for (unordered_map<int, int>::const_iterator it = costDeltas.begin(); it != costDeltas.end(); it++)
+    {
+        int cost = paths.costs[it->first] - it->second;
+        if ((cost < bestCost) || ((cost == bestCost) && (it->first < best)))
+        {
+            best = it->first;
+            bestCost = cost;
+        }
+    }
+    
+    return best;
+}
@@ -0,0 +1,84 @@
+//===============================================================================//
+// Name			: statedelta.h
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Description	: Changes to the solve state of an AND-OR graph, kept apart from the graph
+//===============================================================================//
+
+#ifndef STATEDELTA_H
+#define STATEDELTA_H
+
+#include <unordered_map>
+
+#include "aograph.h"
+
+using namespace std;
+
+//! class "StateDelta" for nodes solved on top of the state of a graph, without changing it
+//! N.B. base of Session and StateOverlay: the graph (compiled graph, nodes and
+//! paths) is only read, and the changes are kept apart (solved and feasible
+//! nodes, costs subtracted from the updated paths). The changes are valid as
+//! long as the graph is not modified (no node solved, no cost changed)
+class StateDelta
+{
+    protected:
+        const AOgraph* aograph;         //!< graph whose state is the base of the changes
+        vector<bool> solved;            //!< solved: the node has been solved on top of the graph
+        vector<bool> feasible;          //!< feasible: the node has become feasible on top of the graph
+        vector<bool> updated;           //!< updated: solving the node on top of the graph updated the paths
+        unordered_map<int, int> costDeltas;     //!< costs subtracted to each updated path
+        bool ownUpdates;                //!< true if a node solved on top of the graph updated the paths
+        vector<int> pIndices;           //!< indices of the paths updated by the last solved node
+        vector<int> pUpdate;            //!< costs subtracted to the paths updated by the last solved node
+        
+        //! constructor
+        StateDelta();
+        
+        //! use the current state of a graph as the base of the changes
+        void attach(const AOgraph &graph);
+        
+        //! drop all changes (back to the state of the graph)
+        void reset();
+        
+        //! update the feasibility status of the parents of a solved node
+        void updateParentsFeasibility(int idNode);
+        
+        //! determine whether a solved node is checked in a path
+        bool isChecked(int index, int idNode) const;
+        
+        //! find the feasible node to suggest along a path
+        int suggestNode(int index) const;
+    
+    public:
+        //! suggest the node to solve
+        string suggestNext(bool strategy);
+        
+        //! solve a node, finding it by name
+        void solveByName(string nameNode);
+        
+        //! solve a node, finding it by identifier
+        void solveById(int idNode);
+        
+        //! find the feasible nodes not solved yet
+        vector<int> getFrontier() const;
+        
+        //! determine whether a node is solved
+        bool isSolved(int idNode) const;
+        
+        //! determine whether a node is feasible
+        bool isFeasible(int idNode) const;
+        
+        //! overall cost of a path
+        int pathCost(int index) const;
+        
+        //! find the optimal path (long-sighted strategy)
+        int findOptimalPath() const;
+        
+        //! destructor
+		~StateDelta()
+		{
+			//DEBUG:cout<<endl <<"Destroying StateDelta object" <<endl;
+		}
+};
+
+#endif
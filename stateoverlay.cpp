@@ -0,0 +1,33 @@
+//===============================================================================//
+// Name			: stateoverlay.cpp
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Description	: What-if evaluation on an AND-OR graph, without changing its state
+//===============================================================================//
+
+#include "stateoverlay.h"
+
+//! constructor of class StateOverlay
+//! @param[in] graph    graph whose current state is the base of the overlay (paths engine)
+StateOverlay::StateOverlay(const AOgraph &graph)
+{
+    // raise an error if the graph cannot be the base of the overlay
+    if (graph.gEngine != ENGINE_PATHS)
+    {
+        ENDOR_MESSAGE("[ERROR] A state overlay requires a graph using the paths engine.");
+        return;
+    }
+    if ((graph.head == NULL) || (graph.paths.size() == 0))
+    {
+        ENDOR_MESSAGE("[ERROR] There are no paths navigating the graph. "
+            <<"Did you load the graph?");
+        return;
+    }
+    attach(graph);
+}
+
+//! drop the hypotheses (back to the state of the graph)
+void StateOverlay::clear()
+{
+    reset();
+}
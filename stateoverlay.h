@@ -0,0 +1,36 @@
+//===============================================================================//
+// Name			: stateoverlay.h
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Description	: What-if evaluation on an AND-OR graph, without changing its state
+//===============================================================================//
+
+#ifndef STATEOVERLAY_H
+#define STATEOVERLAY_H
+
+#include "statedelta.h"
+
+using namespace std;
+
+//! class "StateOverlay" for the hypothesis that some nodes of a graph are solved
+//! N.B. the overlay records only the changes to the current state of the graph
+//! (solved and feasible nodes, costs of the updated paths): the graph is not
+//! modified, and the overlay is valid until a node of the graph is solved.
+//! Overlays only read the graph: they can be used from different threads
+class StateOverlay : public StateDelta
+{
+    public:
+        //! constructor
+        StateOverlay(const AOgraph &graph);
+        
+        //! drop the hypotheses (back to the state of the graph)
+        void clear();
+        
+        //! destructor
+		~StateOverlay()
+		{
+			//DEBUG:cout<<endl <<"Destroying StateOverlay object" <<endl;
+		}
+};
+
+#endif
@@ -0,0 +1,117 @@
+//===============================================================================//
+// Name			: threadcheck.cpp
+// Author(s)	: Barbara Bruno, Yeshasvi Tirupachuri V.S.
+// Affiliation	: University of Genova, Italy - dept. DIBRIS
+// Version		: 1.0
+// Description	: Check of the paths generated by several threads against one thread
+//===============================================================================//
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+#include "aograph.h"
+#include "graphgenerator.h"
+
+using namespace std;
+
+// load a graph without displaying its events
+void loadQuiet(AOgraph &graph, const string &fileName, int numThreads)
+{
+    graph.removeObserver(&graph.textObserver);
+    graph.setGenerationThreads(numThreads);
+    graph.loadFromFile(fileName);
+}
+
+// determine whether two sets of paths have the same steps, paths and costs (same indices)
+bool samePaths(const PathStore &paths, const PathStore &other)
+{
+    if ((paths.size() != other.size()) || (paths.steps.size() != other.steps.size())
+        || (paths.costs != other.costs))
+        return false;
+    
+    for (int i=0; i< (int)paths.steps.size(); i++)
+    {
+        const PathStep &step = paths.steps[i];
+        const PathStep &otherStep = other.steps[i];
+        if ((step.sParent != otherStep.sParent) || (step.sNode != otherStep.sNode) || (step.sArc != otherStep.sArc))
+            return false;
+    }
+    for (int i=0; i< paths.size(); i++)
+    {
+        const PathEntry &entry = paths.entries[i];
+        const PathEntry &otherEntry = other.entries[i];
+        if ((entry.eLastStep != otherEntry.eLastStep) || (entry.eLength != otherEntry.eLength)
+            || (entry.eComplete != otherEntry.eComplete) || (entry.eChecked != otherEntry.eChecked))
+            return false;
+    }
+    
+    return true;
+}
+
+// check the paths generated by several threads on one graph
+int checkGraph(const string &fileName)
+{
+    AOgraph serial("SERIAL");
+    loadQuiet(serial, fileName, 1);
+    
+    // N.B. the threads take and steal the tasks in a different order at each
+    // load: each number of threads is loaded several times
+    int failed = 0;
+    int threads[] = {2, 3, 8};
+    for (int i=0; i< 3; i++)
+    {
+        for (int repeat = 0; repeat < 3; repeat++)
+        {
+            AOgraph parallel("PARALLEL");
+            loadQuiet(parallel, fileName, threads[i]);
+            if (samePaths(serial.paths, parallel.paths) == false)
+            {
+                cout<<"[ERROR] " <<fileName <<": the paths generated by " <<threads[i]
+                    <<" threads differ from the ones of one thread." <<endl;
+                failed++;
+                break;
+            }
+            if (parallel.suggestNext(true) != serial.suggestNext(true))
+            {
+                cout<<"[ERROR] " <<fileName <<": the suggestions with " <<threads[i] <<" threads differ." <<endl;
+                failed++;
+                break;
+            }
+        }
+    }
+    
+    return failed;
+}
+
+int main(int argc, char **argv)
+{
+    int numGraphs = (argc > 1) ? atoi(argv[1]) : 12;
+    int failed = 0;
+    int numChecked = 0;
+    for (int i=0; i< numGraphs; i++)
+    {
+        // trees and graphs with shared nodes, up to some ten thousand paths
+        GraphSettings settings;
+        settings.depth = 2 + i % 3;
+        settings.orBranching = 2 + i % 2;
+        settings.andFanout = 2;
+        settings.sharing = (i % 2 == 0) ? 0.0 : 0.4;
+        settings.seed = i+1;
+        GraphGenerator generator(settings);
+        generator.generate();
+        if (generator.countPaths() > 20000)
+            continue;
+        string fileName = "threadcheck_" + settings.graphName() + ".txt";
+        if (generator.writeDescription(fileName) == false)
+            return 1;
+        
+        failed = failed + checkGraph(fileName);
+        numChecked++;
+        remove(fileName.c_str());
+    }
+    
+    cout<<"[REPORT] " <<numChecked <<" graphs: " <<failed <<" failed checks of the generation threads." <<endl;
+    
+    return (failed == 0) ? 0 : 1;
+}